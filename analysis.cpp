@@ -0,0 +1,224 @@
+#include "statistics.hpp"
+#include "spiketext.hpp"
+#include "constant.hpp"
+
+#include <iostream>
+#include <cstdlib>
+#include <cmath>
+#include <vector>
+#include <thread>
+#include <algorithm>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+using namespace std;
+
+/*
+ * analysis programm
+ *
+ * reads the spikes written by Network::printSpikeTimes (one "time	neuron"
+ * line per spike), computes the statistics of the population and tells in
+ * which of the regimes of Brunel the simulation is:
+ * 	SR synchronous regular		SI synchronous irregular
+ * 	AR asynchronous regular		AI asynchronous irregular
+ *
+ * the file is mapped in memory and parsed by several threads, each one
+ * reading the lines of its own part of the file
+ *
+ * use: ./analysis [file] [t_stop] [workers]
+ * (by default data_neuro.txt, t_stop given by the last spike and one
+ * worker per core)
+ */
+
+//width of a bin of the rates (1ms)
+static const unsigned int rateBin(10);
+
+//number of pairs sampled for the cross-correlations
+static const size_t correlationPairs(1000);
+
+//a population is synchronous above this synchrony index
+static const double synchronyThreshold(0.3);
+
+//a population is irregular above this mean CV
+static const double irregularityThreshold(0.5);
+
+//below this mean rate [Hz] the network is considered silent
+static const double silenceThreshold(0.1);
+
+int main(int argc, char **argv)
+{
+	const char* name = (argc > 1) ? argv[1] : "data_neuro.txt";
+	unsigned int t_stop = (argc > 2) ? atoi(argv[2]) : 0;
+	unsigned int workers = (argc > 3) ? atoi(argv[3]) : thread::hardware_concurrency();
+	if(workers == 0)
+	{
+		workers = 1;
+	}
+
+	int fd = open(name, O_RDONLY);
+	struct stat info;
+	if(fd < 0 or fstat(fd, &info) != 0)
+	{
+		cerr << "Error while opening the file " << name << endl;
+		return 1;
+	}
+
+	size_t size = info.st_size;
+	const char* data(nullptr);
+	if(size > 0)
+	{
+		void* map = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if(map == MAP_FAILED)
+		{
+			cerr << "Error while mapping the file " << name << endl;
+			close(fd);
+			return 1;
+		}
+		data = static_cast<const char*>(map);
+		madvise(map, size, MADV_SEQUENTIAL);
+	}
+
+	//the file is cut in one part of whole lines per worker
+	vector<const char*> cuts = cutSpikeText(data, size, workers);
+
+	vector< vector<SpikeLine> > parts(workers);
+	vector<thread> threads;
+	for (size_t w(1); w<workers; ++w)
+	{
+		threads.push_back(thread(parseSpikeText, cuts[w], cuts[w+1], ref(parts[w])));
+	}
+	parseSpikeText(cuts[0], cuts[1], parts[0]);
+	for (size_t w(0); w<threads.size(); ++w)
+	{
+		threads[w].join();
+	}
+
+	if(size > 0)
+	{
+		munmap(const_cast<char*>(data), size);
+	}
+	close(fd);
+
+	//the spikes are gathered neuron by neuron
+	int neurons(N);
+	double last(0.0);
+	for (size_t w(0); w<workers; ++w)
+	{
+		for (size_t k(0); k<parts[w].size(); ++k)
+		{
+			neurons = max(neurons, parts[w][k].neuron+1);
+			last = max(last, parts[w][k].time);
+		}
+	}
+
+	vector< vector<double> > trains(neurons);
+	for (size_t w(0); w<workers; ++w)
+	{
+		for (size_t k(0); k<parts[w].size(); ++k)
+		{
+			trains[parts[w][k].neuron].push_back(parts[w][k].time);
+		}
+		vector<SpikeLine>().swap(parts[w]);
+	}
+	for (size_t i(0); i<trains.size(); ++i)
+	{
+		if(!is_sorted(trains[i].begin(), trains[i].end()))
+		{
+			sort(trains[i].begin(), trains[i].end());
+		}
+	}
+
+	if(t_stop == 0)
+	{
+		t_stop = last+1;
+	}
+
+	Statistics stats(trains, t_stop, workers);
+
+	double rate = stats.getMeanRate();
+	vector<double> cv = stats.getCV();
+	double meanCV = stats.getMeanCV();
+	double synchrony = stats.getSynchrony(rateBin);
+
+	vector<double> power = stats.getPowerSpectrum(rateBin);
+	size_t peak = (power.size() > 1) ? 1 : 0;
+	double total(0.0);
+	for (size_t k(1); k<power.size(); ++k)
+	{
+		total += power[k];
+		if(power[k] > power[peak])
+		{
+			peak = k;
+		}
+	}
+
+	vector<double> correlations = stats.getCrossCorrelation(correlationPairs, rateBin);
+	double meanCorrelation(0.0);
+	for (size_t k(0); k<correlations.size(); ++k)
+	{
+		meanCorrelation += correlations[k];
+	}
+	if(!correlations.empty())
+	{
+		meanCorrelation /= correlations.size();
+	}
+
+	vector<double> population = stats.getPopulationRate(rateBin);
+	double popMean(0.0),
+		   popVar(0.0);
+	for (size_t k(0); k<population.size(); ++k)
+	{
+		popMean += population[k];
+	}
+	popMean /= max(population.size(), size_t(1));
+	for (size_t k(0); k<population.size(); ++k)
+	{
+		popVar += (population[k]-popMean)*(population[k]-popMean);
+	}
+	popVar /= max(population.size(), size_t(1));
+
+	cout << "---" << name << "---" << endl;
+	cout << "neurons          " << neurons << endl;
+	cout << "duration         " << t_stop*h_ms << "ms" << endl;
+	cout << "spikes           " << stats.getNumberOfSpike() << endl;
+	cout << "mean rate        " << rate << "Hz" << endl;
+	cout << "population rate  " << popMean << " +/- " << sqrt(popVar) << " spikes/ms" << endl;
+	cout << "spectrum peak    " << peak*stats.getFrequencyResolution(rateBin) << "Hz ("
+		 << ((total > 0) ? 100*power[peak]/total : 0.0) << "% of the power)" << endl;
+	cout << "synchrony        " << synchrony << endl;
+	cout << "mean CV          " << meanCV << " (" << cv.size() << " neurons)" << endl;
+
+	//distribution of the CVs by steps of 0.2
+	vector<size_t> histogram(10, 0);
+	for (size_t k(0); k<cv.size(); ++k)
+	{
+		++histogram[min(size_t(cv[k]/0.2), histogram.size()-1)];
+	}
+	for (size_t k(0); k<histogram.size(); ++k)
+	{
+		cout << "   CV " << k*0.2 << (k+1 < histogram.size() ? "-" : "+  ");
+		if(k+1 < histogram.size())
+		{
+			cout << (k+1)*0.2;
+		}
+		cout << "\t" << histogram[k] << endl;
+	}
+
+	cout << "correlation      " << meanCorrelation << " (" << correlations.size() << " pairs)" << endl;
+
+	string regime;
+	if(rate < silenceThreshold)
+	{
+		regime = "silent";
+	}
+	else
+	{
+		regime = (synchrony > synchronyThreshold) ? "S" : "A";
+		regime += (meanCV > irregularityThreshold) ? "I" : "R";
+	}
+	cout << "regime           " << regime << endl;
+
+	return 0;
+}
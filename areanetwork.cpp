@@ -0,0 +1,462 @@
+#include "areanetwork.hpp"
+
+#include <iostream>
+#include <cmath>
+#include <algorithm>
+
+using namespace std;
+
+	//////////////////////////////
+	//                          //
+	//		  Declarations		//
+	//                          //
+	//////////////////////////////
+
+unsigned int NetworkBuilder::addPopulation(const string& name, unsigned int size, neuron_type type,
+										   double noise)
+{
+	int found = findPopulation(name);
+	if(found >= 0)
+	{
+		cerr << "ERROR: the population " << name << " already exists" << endl;
+		return found;
+	}
+
+	if(noise < 0)
+	{
+		cerr << "ERROR: negative noise for the population " << name << endl;
+		noise = 0.0;
+	}
+
+	unsigned int begin = getNumberOfNeurons();
+	Population population = {name, begin, begin+size, type, noise};
+	populations_.push_back(population);
+
+	return populations_.size()-1;
+}
+
+unsigned int NetworkBuilder::addArea(const string& name, unsigned int ne, unsigned int ni)
+{
+	//in-degrees computed like Ce and Ci in constant.hpp
+	int ce = 0.1*ne;
+	int ci = 0.1*ni;
+
+	unsigned int exc = addPopulation(name + ".E", ne, E, V_ext*ce);
+	unsigned int inh = addPopulation(name + ".I", ni, I, V_ext*ce);
+
+	addProjection(exc, exc, IN_DEGREE, ce, Je);
+	addProjection(exc, inh, IN_DEGREE, ce, Je);
+	addProjection(inh, exc, IN_DEGREE, ci, Ji);
+	addProjection(inh, inh, IN_DEGREE, ci, Ji);
+
+	return exc;
+}
+
+bool NetworkBuilder::addProjection(unsigned int source, unsigned int target, connection_rule rule,
+								   double value, double weight, unsigned int delay)
+{
+	if(source >= populations_.size() or target >= populations_.size())
+	{
+		cerr << "ERROR: projection between unknown populations" << endl;
+		return false;
+	}
+
+	if(delay < 1 or delay > unsigned(D))
+	{
+		cerr << "ERROR: the delay of a projection has to be between 1 and " << D << endl;
+		return false;
+	}
+
+	if(rule == PROBABILITY and (value < 0 or value > 1))
+	{
+		cerr << "ERROR: the probability of a projection has to be in [0,1]" << endl;
+		return false;
+	}
+
+	if(rule == IN_DEGREE)
+	{
+		//a neuron is not connected to itself
+		const Population& s = populations_[source];
+		unsigned int sources = (s.end-s.begin) - (source == target ? 1 : 0);
+
+		if(value < 0 or value != floor(value) or (value > 0 and sources == 0))
+		{
+			cerr << "ERROR: the in-degree of a projection has to be a natural number"
+				 << " and the source cannot be empty" << endl;
+			return false;
+		}
+	}
+
+	Projection projection = {source, target, rule, value, weight, delay};
+	projections_.push_back(projection);
+
+	return true;
+}
+
+	//////////////////////////////
+	//                          //
+	//			Getters			//
+	//                          //
+	//////////////////////////////
+
+int NetworkBuilder::findPopulation(const string& name) const
+{
+	for (size_t p(0); p<populations_.size(); ++p)
+	{
+		if(populations_[p].name == name)
+		{
+			return p;
+		}
+	}
+	return -1;
+}
+
+const vector<Population>& NetworkBuilder::getPopulations() const
+{
+	return populations_;
+}
+
+const vector<Projection>& NetworkBuilder::getProjections() const
+{
+	return projections_;
+}
+
+unsigned int NetworkBuilder::getNumberOfNeurons() const
+{
+	return populations_.empty() ? 0 : populations_.back().end;
+}
+
+	//////////////////////////////
+	//                          //
+	// constructor & destructor //
+	//                          //
+	//////////////////////////////
+
+template <class Model>
+AreaNetworkT<Model>::AreaNetworkT(const NetworkBuilder& builder, unsigned int seed, page_mode pages)
+		:arena_(pages),
+		 populations_(builder.getPopulations()),
+		 projections_(builder.getProjections()),
+		 neurons_(ArenaAllocator< NeuronT<Model> >(&arena_)),
+		 offsets_(ArenaAllocator<int>(&arena_)),
+		 targets_(ArenaAllocator<int>(&arena_)),
+		 outgoing_(populations_.size()),
+		 netClock_(0),
+		 gen_(seed),
+		 spikes_(0)
+{
+	//the neurons are laid out population after population
+	neurons_.reserve(builder.getNumberOfNeurons());
+
+	for (size_t p(0); p<populations_.size(); ++p)
+	{
+		const Population& pop = populations_[p];
+
+		//a population without noise never draws from its distribution
+		noise_.push_back(poisson_distribution<int>(pop.noise > 0 ? pop.noise : 1.0));
+
+		for (unsigned int i(pop.begin); i<pop.end; ++i)
+		{
+			neurons_.push_back(NeuronT<Model>(pop.type, &arena_));
+		}
+	}
+
+	//each projection has one row per neuron of its source
+	size_t rows(0);
+	for (size_t p(0); p<projections_.size(); ++p)
+	{
+		const Population& source = populations_[projections_[p].source];
+
+		rows_.push_back(rows);
+		rows += source.end-source.begin + 1;
+		outgoing_[projections_[p].source].push_back(p);
+	}
+	offsets_.assign(rows, 0);
+
+	/*
+	 * as in NetworkT the connections are drawn twice with the same random
+	 * numbers: the first pass counts the targets of each row and the
+	 * second one writes them, so the rows are allocated once for all the
+	 * projections
+	 */
+	mt19937 first(gen_);
+	vector<int> fill;
+
+	for (int pass(0); pass<2; ++pass)
+	{
+		gen_ = first;
+
+		for (size_t p(0); p<projections_.size(); ++p)
+		{
+			connect(p, pass, fill);
+		}
+
+		if(pass == 0)
+		{
+			//the rows of a projection follow the ones of the previous one
+			int total(0);
+			for (size_t p(0); p<projections_.size(); ++p)
+			{
+				const Population& source = populations_[projections_[p].source];
+				size_t base = rows_[p];
+
+				offsets_[base] = total;
+				for (size_t k(0); k<source.end-source.begin; ++k)
+				{
+					offsets_[base+k+1] += offsets_[base+k];
+				}
+				total = offsets_[base + source.end-source.begin];
+			}
+
+			targets_.resize(total);
+			fill.assign(offsets_.begin(), offsets_.end());
+		}
+	}
+}
+
+template <class Model>
+AreaNetworkT<Model>::~AreaNetworkT()
+{
+	neurons_.clear();
+	offsets_.clear();
+	targets_.clear();
+}
+
+template <class Model>
+void AreaNetworkT<Model>::connect(size_t p, int pass, vector<int>& fill)
+{
+	const Projection& proj = projections_[p];
+	const Population& source = populations_[proj.source];
+	const Population& target = populations_[proj.target];
+	bool same = (proj.source == proj.target);
+	size_t base = rows_[p];
+
+	auto place = [&](unsigned int pre, unsigned int post)
+	{
+		size_t row = base + pre-source.begin;
+		if(pass == 0)
+		{
+			++offsets_[row+1];
+		}
+		else
+		{
+			targets_[fill[row]++] = post;
+		}
+	};
+
+	if(proj.rule == IN_DEGREE)
+	{
+		/*
+		 * each target draws its sources (other than itself); the targets
+		 * come in order, so every row is sorted
+		 */
+		int degree = proj.value;
+		if(degree == 0)
+		{
+			return;
+		}
+
+		uniform_int_distribution<> dis(source.begin, source.end-1);
+
+		for (unsigned int post(target.begin); post<target.end; ++post)
+		{
+			for (int k(0); k<degree; ++k)
+			{
+				unsigned int r(0);
+
+				do
+				{
+					r = dis(gen_);
+				}while(same and r == post);
+
+				place(r, post);
+			}
+		}
+		return;
+	}
+
+	if(proj.value <= 0)
+	{
+		return;
+	}
+
+	/*
+	 * each source jumps from one target to the next one with a geometric
+	 * number of misses, so the cost of a projection is its number of
+	 * connections and not the number of pairs of neurons
+	 */
+	//a probability of 1 connects every pair (the distribution needs p<1)
+	geometric_distribution<long long> skip((proj.value < 1) ? proj.value : 0.5);
+
+	for (unsigned int pre(source.begin); pre<source.end; ++pre)
+	{
+		long long post = target.begin - 1;
+
+		while(true)
+		{
+			post += 1 + ((proj.value < 1) ? skip(gen_) : 0);
+			if(post >= target.end)
+			{
+				break;
+			}
+			if(!same or post != pre)
+			{
+				place(pre, post);
+			}
+		}
+	}
+}
+
+	//////////////////////////////
+	//                          //
+	//			Getters			//
+	//                          //
+	//////////////////////////////
+
+template <class Model>
+unsigned int AreaNetworkT<Model>::getNumberOfNeurons() const
+{
+	return neurons_.size();
+}
+
+template <class Model>
+const vector<Population>& AreaNetworkT<Model>::getPopulations() const
+{
+	return populations_;
+}
+
+template <class Model>
+const vector<Projection>& AreaNetworkT<Model>::getProjections() const
+{
+	return projections_;
+}
+
+template <class Model>
+size_t AreaNetworkT<Model>::getNumberOfConnections(size_t projection) const
+{
+	if(projection >= projections_.size())
+	{
+		return 0;
+	}
+
+	const Population& source = populations_[projections_[projection].source];
+	size_t base = rows_[projection];
+
+	return offsets_[base + source.end-source.begin] - offsets_[base];
+}
+
+template <class Model>
+size_t AreaNetworkT<Model>::getNumberOfConnections() const
+{
+	return targets_.size();
+}
+
+template <class Model>
+vector<int> AreaNetworkT<Model>::getTargets(size_t projection, unsigned int pre) const
+{
+	if(projection >= projections_.size())
+	{
+		return vector<int>();
+	}
+
+	const Population& source = populations_[projections_[projection].source];
+	if(pre < source.begin or pre >= source.end)
+	{
+		return vector<int>();
+	}
+
+	size_t row = rows_[projection] + pre-source.begin;
+	return vector<int>(targets_.begin()+offsets_[row], targets_.begin()+offsets_[row+1]);
+}
+
+template <class Model>
+vector< vector<double> > AreaNetworkT<Model>::getSpikeTrains() const
+{
+	vector< vector<double> > trains(neurons_.size());
+
+	for (size_t i(0); i<neurons_.size(); ++i)
+	{
+		trains[i] = neurons_[i].getSpikeTimes();
+	}
+
+	return trains;
+}
+
+template <class Model>
+unsigned int AreaNetworkT<Model>::getClock() const
+{
+	return netClock_;
+}
+
+template <class Model>
+size_t AreaNetworkT<Model>::getNumberOfSpike() const
+{
+	return spikes_;
+}
+
+template <class Model>
+size_t AreaNetworkT<Model>::getFootprint() const
+{
+	return arena_.getFootprint();
+}
+
+	//////////////////////////////
+	//                          //
+	//		  Simulation		//
+	//                          //
+	//////////////////////////////
+
+template <class Model>
+void AreaNetworkT<Model>::runSimulation(unsigned int t_stop)
+{
+	while(netClock_ < t_stop)
+	{
+		update();
+
+		++netClock_;
+	}
+}
+
+template <class Model>
+void AreaNetworkT<Model>::update()
+{
+	for (size_t p(0); p<populations_.size(); ++p)
+	{
+		const Population& pop = populations_[p];
+		const vector<unsigned int>& outgoing = outgoing_[p];
+
+		for (unsigned int i(pop.begin); i<pop.end; ++i)
+		{
+			//external random noise recieved by the neuron during this step
+			//(drawn only if it integrates it, like in NetworkT)
+			double Jext = (pop.noise > 0 and neurons_[i].integrates()) ? noise_[p](gen_)*Je : 0.0;
+
+			if(!neurons_[i].step(0.0, Jext))
+			{
+				continue;
+			}
+
+			++spikes_;
+
+			//the spike is delivered by each projection of the population
+			for (size_t k(0); k<outgoing.size(); ++k)
+			{
+				const Projection& proj = projections_[outgoing[k]];
+				size_t row = rows_[outgoing[k]] + i-pop.begin;
+
+				for (int j(offsets_[row]); j<offsets_[row+1]; ++j)
+				{
+					neurons_[targets_[j]].setBufferAt(netClock_+proj.delay, proj.weight);
+				}
+			}
+		}
+	}
+}
+
+	//////////////////////////////
+	//                          //
+	//	   Instantiations		//
+	//                          //
+	//////////////////////////////
+
+template class AreaNetworkT<LIF>;
@@ -0,0 +1,289 @@
+#ifndef areanetwork_HPP
+#define areanetwork_HPP
+
+#include "neuron.hpp"
+#include "arena.hpp"
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <random>
+
+using namespace std;
+
+/*
+ * tells how the connections of a projection are drawn:
+ * PROBABILITY: each pair of neurons is connected with a given probability
+ * IN_DEGREE: each target neuron recieves a given number of connections
+ * 		 from sources drawn at random (a source can be drawn twice)
+ */
+enum connection_rule{PROBABILITY, IN_DEGREE};
+
+/*!
+ * @brief group of neurons of the same type, with the same external noise
+ */
+struct Population
+{
+	string name;
+
+	//!first and last+1 neurons of the population in the network
+	unsigned int begin, end;
+
+	neuron_type type;
+
+	//!mean number of external spikes (of amplitude Je) recieved in a step
+	double noise;
+};
+
+/*!
+ * @brief connections from a source population to a target population
+ */
+struct Projection
+{
+	//!indices of the populations
+	unsigned int source, target;
+
+	connection_rule rule;
+
+	//!probability of a connection or in-degree, depending on the rule
+	double value;
+
+	//!amplitude transmitted by a spike [mvolt] and delay !in steps h!
+	double weight;
+	unsigned int delay;
+};
+
+/*!
+ * @brief network builder class
+ *
+ * this class declares the populations of a network and the projections
+ * between them; it only checks them, the neurons and the connections are
+ * laid out by AreaNetworkT. The neurons of a population get consecutive
+ * indices, in the order the populations are added
+ */
+class NetworkBuilder
+{
+	private:
+
+		vector<Population> populations_;
+		vector<Projection> projections_;
+
+	public:
+
+	//////////////////////////////
+	//                          //
+	//		  Declarations		//
+	//                          //
+	//////////////////////////////
+
+		/*!
+		 * @brief add a population after the others
+		 *
+		 * @param string name name of the population (unique)
+		 * @param unsigned int size number of neurons
+		 * @param neuron_type type E or I
+		 * @param double noise mean number of external spikes in a step
+		 *
+		 * @return unsigned int index of the population
+		 */
+		unsigned int addPopulation(const string& name, unsigned int size, neuron_type type,
+								   double noise = V_ext*Ce);
+
+		/*!
+		 * @brief add an area: an excitatory population name.E and an
+		 * 		  inhibitory one name.I connected like NetworkT
+		 *
+		 * each neuron of the area recieves 10% of ne from name.E (weight
+		 * Je) and 10% of ni from name.I (weight Ji) with the delay D, and
+		 * V_ext times its excitatory in-degree external spikes in a step
+		 *
+		 * @return unsigned int index of name.E (name.I comes next)
+		 */
+		unsigned int addArea(const string& name, unsigned int ne, unsigned int ni);
+
+		/*!
+		 * @brief add a projection between two populations
+		 *
+		 * @param unsigned int source, target indices of the populations
+		 * @param connection_rule rule PROBABILITY or IN_DEGREE
+		 * @param double value probability in [0,1] or in-degree
+		 * @param double weight amplitude transmitted by a spike [mvolt]
+		 * @param unsigned int delay delay of the spikes, from 1 to D
+		 *
+		 * @return bool false if the projection is not valid (it is not
+		 * 		   added)
+		 */
+		bool addProjection(unsigned int source, unsigned int target, connection_rule rule,
+						   double value, double weight, unsigned int delay = D);
+
+	//////////////////////////////
+	//                          //
+	//			Getters			//
+	//                          //
+	//////////////////////////////
+
+		/*!
+		 * @brief get the index of a population, -1 if there is none of
+		 * 		  this name
+		 */
+		int findPopulation(const string& name) const;
+
+		const vector<Population>& getPopulations() const;
+
+		const vector<Projection>& getProjections() const;
+
+		/*!
+		 * @brief get the number of neurons of all the populations
+		 */
+		unsigned int getNumberOfNeurons() const;
+};
+
+/*!
+ * @brief network of several populations class
+ *
+ * this class simulates a network declared with a NetworkBuilder, for
+ * models made of several areas each with its own populations. The neurons
+ * are laid out population after population and the connections projection
+ * after projection: each projection has its own rows (one per source
+ * neuron) in which the targets are sorted. A spike is delivered projection
+ * by projection, each with its weight and its delay, so the delivery reads
+ * contiguous rows and a sparse projection only costs its synapses and
+ * one offset per source neuron.
+ *
+ * the building and the update follow NetworkT in push mode (the clock of
+ * a neuron stops during the step of its spikes in the same way); the other
+ * delivery modes, the plasticity and the streams are not available
+ */
+template <class Model = LIF>
+class AreaNetworkT
+{
+	private:
+
+		//!arena owning all the memory of the simulation
+		//!(declared first so that it is destroyed last)
+		Arena arena_;
+
+		//!populations and projections of the network
+		vector<Population> populations_;
+		vector<Projection> projections_;
+
+		//!neurons of every population, one after the other
+		vector< NeuronT<Model>, ArenaAllocator< NeuronT<Model> > > neurons_;
+
+		//!rows of the projections: the targets of the k-th neuron of the
+		//!source of the projection p are targets_[offsets_[rows_[p]+k]]
+		//!... targets_[offsets_[rows_[p]+k+1]-1]
+		vector<size_t> rows_;
+		vector<int, ArenaAllocator<int> > offsets_;
+		vector<int, ArenaAllocator<int> > targets_;
+
+		//!projections leaving each population
+		vector< vector<unsigned int> > outgoing_;
+
+		//!local clock of the network
+		unsigned int netClock_;
+
+		//!random generator used for the connections and the external noise
+		mt19937 gen_;
+
+		//!distribution of the external noise of each population
+		vector< poisson_distribution<int> > noise_;
+
+		//!number of spikes since the network was built
+		size_t spikes_;
+
+		/*!
+		 * @brief draw the connections of a projection; the first pass
+		 * 		  counts the targets of each row, the second writes them
+		 * 		  at the places given by fill
+		 */
+		void connect(size_t p, int pass, vector<int>& fill);
+
+	public:
+
+	//////////////////////////////
+	//                          //
+	// constructor & destructor //
+	//                          //
+	//////////////////////////////
+
+		/*!
+		 * @brief lay out the neurons and draw the connections declared by
+		 * 		  a builder
+		 *
+		 * @param NetworkBuilder builder the populations and projections
+		 * @param unsigned int seed seed of the random generator
+		 * @param page_mode pages how the memory of the network is backed
+		 */
+		AreaNetworkT(const NetworkBuilder& builder, unsigned int seed, page_mode pages = STANDARD);
+
+		/*!
+		 * @brief destructor
+		 */
+		~AreaNetworkT();
+
+	//////////////////////////////
+	//                          //
+	//			Getters			//
+	//                          //
+	//////////////////////////////
+
+		unsigned int getNumberOfNeurons() const;
+
+		const vector<Population>& getPopulations() const;
+
+		const vector<Projection>& getProjections() const;
+
+		/*!
+		 * @brief get the number of connections of a projection
+		 */
+		size_t getNumberOfConnections(size_t projection) const;
+
+		/*!
+		 * @brief get the number of connections of the network
+		 */
+		size_t getNumberOfConnections() const;
+
+		/*!
+		 * @brief get the targets of a neuron in a projection (sorted)
+		 *
+		 * @param size_t projection index of the projection
+		 * @param unsigned int pre index of the neuron in the network
+		 */
+		vector<int> getTargets(size_t projection, unsigned int pre) const;
+
+		/*!
+		 * @brief get the spike times of every neuron of the network
+		 */
+		vector< vector<double> > getSpikeTrains() const;
+
+		unsigned int getClock() const;
+
+		size_t getNumberOfSpike() const;
+
+		/*!
+		 * @brief get the memory allocated for the simulation in bytes
+		 */
+		size_t getFootprint() const;
+
+	//////////////////////////////
+	//                          //
+	//		  Simulation		//
+	//                          //
+	//////////////////////////////
+
+		/*!
+		 * @brief run the simulation up to the step t_stop
+		 */
+		void runSimulation(unsigned int t_stop);
+
+		/*!
+		 * @brief update every neuron for one step and deliver its spikes
+		 */
+		void update();
+};
+
+//!the network of several populations used by default
+typedef AreaNetworkT<LIF> AreaNetwork;
+
+#endif
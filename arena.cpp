@@ -0,0 +1,246 @@
+#include "arena.hpp"
+
+#include <iostream>
+#include <cstdint>
+#include <unistd.h>
+#include <sys/mman.h>
+
+using namespace std;
+
+//size of the first region mapped (2MB, one huge page)
+static const size_t firstRegion(size_t(1) << 21);
+
+//blocks bigger than this are not recycled in the free lists, they are
+//mapped apart
+static const size_t biggestClass(size_t(1) << 20);
+
+//size of a huge page, the big blocks backed by huge pages are multiples of it
+static const size_t hugePage(size_t(1) << 21);
+
+	//////////////////////////////
+	//                          //
+	// constructor & destructor //
+	//                          //
+	//////////////////////////////
+
+Arena::Arena(page_mode pages)
+		:next_(nullptr),
+		 end_(nullptr),
+		 regionSize_(firstRegion),
+		 pages_(pages),
+		 used_(0)
+{
+	for (size_t i(0); i<32; ++i)
+	{
+		freeLists_[i] = nullptr;
+	}
+}
+
+Arena::~Arena()
+{
+	for (size_t i(0); i<regions_.size(); ++i)
+	{
+		munmap(regions_[i].begin, regions_[i].size);
+	}
+	regions_.clear();
+	
+	//the big blocks still given to containers
+	for (size_t i(0); i<bigBlocks_.size(); ++i)
+	{
+		munmap(bigBlocks_[i].begin, bigBlocks_[i].size);
+	}
+	bigBlocks_.clear();
+}
+
+	//////////////////////////////
+	//                          //
+	//		  Allocation		//
+	//                          //
+	//////////////////////////////
+
+int Arena::sizeClass(size_t size)
+{
+	if(size > biggestClass)
+	{
+		return -1;
+	}
+
+	int c(4);
+	while((size_t(1) << c) < size)
+	{
+		++c;
+	}
+	return c;
+}
+
+void Arena::newRegion(size_t size)
+{
+	/*
+	 * the regions are multiples of 2MB and get bigger and bigger so
+	 * that a large network only needs a few of them
+	 */
+	while(regionSize_ < size)
+	{
+		regionSize_ *= 2;
+	}
+	size = regionSize_;
+	regionSize_ *= 2;
+
+	Region r = {static_cast<char*>(map(size)), size};
+	regions_.push_back(r);
+
+	next_ = r.begin;
+	end_ = r.begin + size;
+}
+
+void* Arena::map(size_t size)
+{
+	void* p(MAP_FAILED);
+
+#ifdef MAP_HUGETLB
+	if(pages_ == EXPLICIT_HUGE)
+	{
+		p = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+				 MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+
+		if(p == MAP_FAILED)
+		{
+			cerr << "WARNING: no huge page available, the arena uses standard pages" << endl;
+			pages_ = STANDARD;
+		}
+	}
+#endif
+
+	if(p == MAP_FAILED)
+	{
+		p = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+				 MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	}
+
+	if(p == MAP_FAILED)
+	{
+		throw bad_alloc();
+	}
+
+#ifdef MADV_HUGEPAGE
+	if(pages_ == TRANSPARENT_HUGE)
+	{
+		madvise(p, size, MADV_HUGEPAGE);
+	}
+#endif
+
+	return p;
+}
+
+void* Arena::allocate(size_t size)
+{
+	lock_guard<mutex> lock(mutex_);
+	
+	int c = sizeClass(size);
+
+	if(c < 0)
+	{
+		//the big blocks are rounded to whole pages
+		size_t page = (pages_ == STANDARD) ? sysconf(_SC_PAGESIZE) : hugePage;
+		size = (size+page-1)/page*page;
+
+		Region r = {static_cast<char*>(map(size)), size};
+		bigBlocks_.push_back(r);
+		used_ += size;
+		return r.begin;
+	}
+
+	size = size_t(1) << c;
+
+	//a block of the same class given back earlier is reused
+	if(freeLists_[c] != nullptr)
+	{
+		void* p = freeLists_[c];
+		freeLists_[c] = *static_cast<void**>(p);
+		used_ += size;
+		return p;
+	}
+
+	size_t align = (size >= 64) ? 64 : 16;
+	uintptr_t a = (reinterpret_cast<uintptr_t>(next_) + align-1) & ~uintptr_t(align-1);
+	char* p = reinterpret_cast<char*>(a);
+
+	if(next_ == nullptr or p + size > end_)
+	{
+		newRegion(size);
+		p = next_;
+	}
+
+	next_ = p + size;
+	used_ += size;
+
+	return p;
+}
+
+void Arena::deallocate(void* p, size_t size)
+{
+	if(p == nullptr)
+	{
+		return;
+	}
+	
+	lock_guard<mutex> lock(mutex_);
+
+	int c = sizeClass(size);
+
+	if(c >= 0)
+	{
+		size = size_t(1) << c;
+		*static_cast<void**>(p) = freeLists_[c];
+		freeLists_[c] = p;
+		used_ -= size;
+		return;
+	}
+
+	//a big block is given back to the system at once
+	for (size_t i(0); i<bigBlocks_.size(); ++i)
+	{
+		if(bigBlocks_[i].begin == p)
+		{
+			munmap(bigBlocks_[i].begin, bigBlocks_[i].size);
+			used_ -= bigBlocks_[i].size;
+			bigBlocks_[i] = bigBlocks_.back();
+			bigBlocks_.pop_back();
+			return;
+		}
+	}
+}
+
+	//////////////////////////////
+	//                          //
+	//			Getters			//
+	//                          //
+	//////////////////////////////
+
+size_t Arena::getFootprint() const
+{
+	lock_guard<mutex> lock(mutex_);
+	
+	size_t total(0);
+	for (size_t i(0); i<regions_.size(); ++i)
+	{
+		total += regions_[i].size;
+	}
+	for (size_t i(0); i<bigBlocks_.size(); ++i)
+	{
+		total += bigBlocks_[i].size;
+	}
+	return total;
+}
+
+size_t Arena::getUsed() const
+{
+	lock_guard<mutex> lock(mutex_);
+	
+	return used_;
+}
+
+page_mode Arena::getPageMode() const
+{
+	return pages_;
+}
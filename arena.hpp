@@ -0,0 +1,218 @@
+#ifndef arena_HPP
+#define arena_HPP
+
+#include <cstddef>
+#include <new>
+#include <vector>
+#include <mutex>
+
+using namespace std;
+
+//tells how the memory of an arena is backed (standard, transparent or explicit huge pages)
+enum page_mode{STANDARD, TRANSPARENT_HUGE, EXPLICIT_HUGE};
+
+/*!
+ * @brief arena class
+ *
+ * this class owns all the memory of a simulation. It maps large regions
+ * (optionally backed by huge pages to reduce the TLB misses) and gives
+ * small pieces of them to the containers of the network, so that the
+ * connections, the neurons and the spike histories are packed together
+ * instead of being spread in the heap. Everything is released at once
+ * when the arena is destroyed.
+ *
+ * the small blocks given back by the containers (when a vector grows) are
+ * kept in free lists, one for each power of two, and reused; the big
+ * blocks (over 1MB) are mapped apart and unmapped as soon as they are
+ * given back, so that a vector growing or laid out again many times does
+ * not make the footprint grow
+ *
+ * an arena can be shared by several threads (the workers of the pull
+ * delivery store their spikes in it)
+ */
+class Arena
+{
+	private:
+
+		//!a region mapped by the arena
+		struct Region
+		{
+			char* begin;
+			size_t size;
+		};
+
+		//!all the regions mapped by the arena
+		vector<Region> regions_;
+		
+		//!big blocks given to the containers, each mapped apart
+		vector<Region> bigBlocks_;
+
+		//!next free byte of the last region
+		char* next_;
+
+		//!end of the last region
+		char* end_;
+
+		//!size of the next region to map
+		size_t regionSize_;
+
+		//!how the regions are backed
+		page_mode pages_;
+
+		//!number of bytes given to the containers and not given back
+		size_t used_;
+
+		//!free lists of the small blocks (one per power of two)
+		void* freeLists_[32];
+		
+		//!protects the arena when several threads allocate at once
+		//!(or read its size while the simulation runs)
+		mutable mutex mutex_;
+
+		/*!
+		 * @brief map a new region of at least size bytes
+		 */
+		void newRegion(size_t size);
+		
+		/*!
+		 * @brief map size bytes backed as asked by pages_
+		 */
+		void* map(size_t size);
+
+		/*!
+		 * @brief tells in which free list a block of size bytes goes
+		 *
+		 * @return int the size class, -1 if the block is too big
+		 */
+		static int sizeClass(size_t size);
+
+	public:
+
+	//////////////////////////////
+	//                          //
+	// constructor & destructor //
+	//                          //
+	//////////////////////////////
+
+		/*!
+		 * @brief initialise an empty arena, nothing is mapped before the
+		 * 		  first allocation
+		 *
+		 * @param page_mode pages how the regions have to be backed
+		 */
+		Arena(page_mode pages = STANDARD);
+
+		/*!
+		 * @brief destructor: unmap all the regions
+		 */
+		~Arena();
+
+		//an arena owns its memory, it cannot be copied
+		Arena(const Arena&) = delete;
+		Arena& operator=(const Arena&) = delete;
+
+	//////////////////////////////
+	//                          //
+	//		  Allocation		//
+	//                          //
+	//////////////////////////////
+
+		/*!
+		 * @brief give a block of size bytes, aligned on 16 bytes (64 for
+		 * 		  the blocks bigger than a cache line)
+		 */
+		void* allocate(size_t size);
+
+		/*!
+		 * @brief take back a block given by allocate
+		 */
+		void deallocate(void* p, size_t size);
+
+	//////////////////////////////
+	//                          //
+	//			Getters			//
+	//                          //
+	//////////////////////////////
+
+		/*!
+		 * @brief get the number of bytes mapped by the arena
+		 */
+		size_t getFootprint() const;
+
+		/*!
+		 * @brief get the number of bytes currently used by the containers
+		 */
+		size_t getUsed() const;
+
+		/*!
+		 * @brief get how the regions are actually backed (explicit huge
+		 * 		  pages fall back to standard pages if none are available)
+		 */
+		page_mode getPageMode() const;
+};
+
+/*!
+ * @brief allocator giving the memory of an arena to the standard containers
+ *
+ * without arena it uses the heap. The copy of a container is not put in
+ * the arena, so that it can outlive the network it comes from
+ */
+template <class T>
+class ArenaAllocator
+{
+	public:
+
+		typedef T value_type;
+
+		//!arena used, the heap if null
+		Arena* arena_;
+
+		ArenaAllocator(Arena* arena = nullptr)
+				:arena_(arena)
+		{}
+
+		template <class U>
+		ArenaAllocator(const ArenaAllocator<U>& other)
+				:arena_(other.arena_)
+		{}
+
+		T* allocate(size_t n)
+		{
+			if(arena_ == nullptr)
+			{
+				return static_cast<T*>(::operator new(n*sizeof(T)));
+			}
+			return static_cast<T*>(arena_->allocate(n*sizeof(T)));
+		}
+
+		void deallocate(T* p, size_t n)
+		{
+			if(arena_ == nullptr)
+			{
+				::operator delete(p);
+			}
+			else
+			{
+				arena_->deallocate(p, n*sizeof(T));
+			}
+		}
+
+		ArenaAllocator select_on_container_copy_construction() const
+		{
+			return ArenaAllocator();
+		}
+
+		template <class U>
+		bool operator==(const ArenaAllocator<U>& other) const
+		{
+			return arena_ == other.arena_;
+		}
+
+		template <class U>
+		bool operator!=(const ArenaAllocator<U>& other) const
+		{
+			return arena_ != other.arena_;
+		}
+};
+
+#endif
@@ -14,6 +14,9 @@
 	 *the membranne potential have to be modified accordingly
 	 */
 	static const double h(1);
+	
+	//physical duration of a timestep h [ms]
+	static const double h_ms(0.1);
 		
 	//time constant (20 ms)
 	static const double tau(200);
@@ -97,6 +100,27 @@
 	//rate of random spiking from external connections
 	static const double V_ext = 0.2;
 
+//////////////////////////////
+//                          //
+//	  Plasticity constants	//
+//                          //
+//////////////////////////////
+
+	//time constant of the pre-synaptic trace (20 ms)
+	static const double tau_plus(200);
+
+	//time constant of the post-synaptic trace (20 ms)
+	static const double tau_minus(200);
+
+	//potentiation of a weight per pair pre before post [mvolt]
+	static const double A_plus(0.001);
+
+	//depression of a weight per pair post before pre [mvolt]
+	static const double A_minus(0.00105);
+
+	//maximal weight of a plastic synapse [mvolt]
+	static const double J_max(2*Je);
+
 //////////////////////////////
 //                          //
 //		Neuron types		//
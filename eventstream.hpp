@@ -0,0 +1,228 @@
+#ifndef eventstream_HPP
+#define eventstream_HPP
+
+#include <atomic>
+#include <thread>
+#include <cstdint>
+#include <cstddef>
+
+using namespace std;
+
+/*
+ * streams of events between the simulation and a controller
+ *
+ * the network publishes the spikes of each step in a SpikeStream and reads
+ * the currents to inject in an InputStream (see NetworkT::step). Both are
+ * lock-free rings with a single producer and a single consumer: the
+ * producer writes in place and publishes a whole step at once, the
+ * consumer reads the events where they lie and then releases them.
+ *
+ * a ring is a plain block of memory (no pointer, lock-free atomics), so it
+ * can also be built with a placement new in a shared memory segment to
+ * link the simulation to an other process on the same machine
+ */
+
+//!neuron of the events that mark the end of a step
+static const uint32_t endOfStep(UINT32_MAX);
+
+/*!
+ * @brief spike of a neuron, or end of the step time if neuron is endOfStep
+ */
+struct SpikeEvent
+{
+	uint32_t time, neuron;
+};
+
+/*!
+ * @brief current injected in a neuron from the step time on, or if
+ * 		  neuron is endOfStep the end of the input of the steps up to time
+ */
+struct InputCommand
+{
+	uint32_t time, neuron;
+	double current;
+};
+
+/*!
+ * @brief lock-free ring of events with one producer and one consumer
+ *
+ * the producer writes the events with write (they stay invisible) and
+ * makes them visible with publish; the consumer gets the events with
+ * read, which gives a pointer in the ring, and frees them with release.
+ * The two sides each keep a copy of the position of the other so they
+ * only touch the shared cache line when the ring looks full or empty.
+ *
+ * a lossy ring drops and counts a write on a full ring rather than wait,
+ * so that a controller running in the thread of the simulation cannot
+ * block it: the ring has to hold the events of the steps not read yet.
+ * A ring that is not lossy never drops an event: a write on a full ring
+ * fails and has to be made again once the consumer freed some places
+ * (writeWait does it for a producer in its own thread)
+ */
+template <class T, size_t Capacity, bool Lossy = true>
+class EventRing
+{
+	static_assert(Capacity > 0 and (Capacity & (Capacity-1)) == 0,
+				  "the capacity of a ring is a power of 2");
+
+	private:
+
+		//!events published by the producer (written by the producer)
+		alignas(64) atomic<uint64_t> head_;
+
+		//!events written but not published yet and last tail seen
+		//!(producer only)
+		uint64_t pending_, tailSeen_;
+
+		//!events dropped because the ring was full
+		atomic<uint64_t> dropped_;
+
+		//!events released by the consumer (written by the consumer)
+		alignas(64) atomic<uint64_t> tail_;
+
+		//!last head seen (consumer only)
+		uint64_t headSeen_;
+
+		alignas(64) T events_[Capacity];
+
+	public:
+
+		EventRing()
+				:head_(0), pending_(0), tailSeen_(0), dropped_(0), tail_(0), headSeen_(0)
+		{}
+
+		//!a ring cannot be copied (the two sides point at it)
+		EventRing(const EventRing&) = delete;
+		EventRing& operator=(const EventRing&) = delete;
+
+	//////////////////////////////
+	//                          //
+	//			Producer		//
+	//                          //
+	//////////////////////////////
+
+		/*!
+		 * @brief write an event after the others, without publishing it
+		 *
+		 * @return bool false if the ring is full: a lossy ring drops the
+		 * 		   event, an other ring leaves it to the caller
+		 */
+		bool write(const T& event)
+		{
+			if(pending_-tailSeen_ == Capacity)
+			{
+				tailSeen_ = tail_.load(memory_order_acquire);
+				if(pending_-tailSeen_ == Capacity)
+				{
+					if(Lossy)
+					{
+						dropped_.fetch_add(1, memory_order_relaxed);
+					}
+					return false;
+				}
+			}
+
+			events_[pending_ & (Capacity-1)] = event;
+			++pending_;
+			return true;
+		}
+
+		/*!
+		 * @brief make the events written visible to the consumer
+		 */
+		void publish()
+		{
+			head_.store(pending_, memory_order_release);
+		}
+
+		/*!
+		 * @brief write an event, waiting for the consumer while the ring
+		 * 		  is full
+		 *
+		 * the events already written are published before waiting, since
+		 * the consumer cannot free the places they hold otherwise. The
+		 * consumer has to run in an other thread
+		 */
+		void writeWait(const T& event)
+		{
+			while(!write(event))
+			{
+				publish();
+				this_thread::yield();
+			}
+		}
+
+	//////////////////////////////
+	//                          //
+	//			Consumer		//
+	//                          //
+	//////////////////////////////
+
+		/*!
+		 * @brief get the oldest events published and not released
+		 *
+		 * @param const T*& events set to the first of them, inside the ring
+		 *
+		 * @return size_t number of events following it in the ring (the
+		 * 		   ones after its end are given by the next read)
+		 */
+		size_t read(const T*& events)
+		{
+			uint64_t tail = tail_.load(memory_order_relaxed);
+			if(headSeen_ == tail)
+			{
+				headSeen_ = head_.load(memory_order_acquire);
+			}
+
+			size_t first = tail & (Capacity-1);
+			size_t count = headSeen_-tail;
+			if(count > Capacity-first)
+			{
+				count = Capacity-first;
+			}
+
+			events = events_ + first;
+			return count;
+		}
+
+		/*!
+		 * @brief free the n oldest events read
+		 */
+		void release(size_t n)
+		{
+			tail_.store(tail_.load(memory_order_relaxed)+n, memory_order_release);
+		}
+
+	//////////////////////////////
+	//                          //
+	//			Getters			//
+	//                          //
+	//////////////////////////////
+
+		/*!
+		 * @brief get the number of events dropped because the ring was full
+		 * 		  (always 0 if the ring is not lossy)
+		 */
+		uint64_t getDropped() const
+		{
+			return dropped_.load(memory_order_relaxed);
+		}
+
+		/*!
+		 * @brief get the number of events the ring can hold
+		 */
+		static constexpr size_t capacity()
+		{
+			return Capacity;
+		}
+};
+
+//!ring of the spikes, it holds about 120 steps of the default network
+//!(about 530 spikes per step), the spikes of a late reader are dropped
+typedef EventRing<SpikeEvent, (1 << 16)> SpikeStream;
+
+//!ring of the input commands, a command is never lost since it changes
+//!the current of a neuron for good
+typedef EventRing<InputCommand, (1 << 12), false> InputStream;
+
+#endif
@@ -0,0 +1,330 @@
+#ifndef fixednetwork_HPP
+#define fixednetwork_HPP
+
+#include "constant.hpp"
+#include "model.hpp"
+#include "wiring.hpp"
+
+#include <array>
+#include <vector>
+#include <random>
+
+using namespace std;
+
+/*!
+ * @brief network whose size is known at compile time
+ *
+ * this class simulates the same network as NetworkT (same connections
+ * and same external noise for a given seed, push delivery) but for
+ * populations of NE excitatory and NI inhibitory neurons given as template
+ * parameters. All its state lives in fixed size arrays inside the object:
+ * it costs no allocation besides its spike list and its loops have
+ * constant bounds, which is what the small calibration networks need.
+ *
+ * the arrays grow with NE+NI (about (D+1+Ctot)*N doubles), so it is
+ * meant for small networks; it is defined in this header since it is
+ * instantiated for every size used
+ *
+ * it is a separate class rather than a NetworkT of a given size: the size
+ * N of constant.hpp is built into NetworkT and into every part of it
+ * (rewiring, plasticity, streams, noise tapes...), and those parts need
+ * memory laid out at run time. This class only keeps what a calibration
+ * run needs (a constant current, push delivery). The map is drawn by
+ * drawConnections and each neuron is updated by stepModel, like in
+ * NetworkT, and the unit tests compare the two at the size N
+ */
+template <int NE, int NI, class Model = LIF>
+class FixedNetwork
+{
+	public:
+
+		//!number of neurons
+		static constexpr int NN = NE+NI;
+
+		//!number of excitatory and inhibitory connections of each neuron
+		//!(computed like Ce and Ci in constant.hpp)
+		static constexpr int CE = 0.1*NE;
+		static constexpr int CI = 0.1*NI;
+
+		//!total number of connections of the network
+		static constexpr int SYNAPSES = NN*(CE+CI);
+
+		static_assert(NE > 1 and NI > 1, "a population needs at least two neurons");
+
+	private:
+
+		//!state of the model of each neuron
+		array<typename Model::State, NN> state_;
+
+		//!tells if each neuron is refractory
+		array<bool, NN> refractory_;
+
+		//!clock of each neuron (it stops during the step of a spike,
+		//!like the clock of NeuronT)
+		array<unsigned int, NN> clocks_;
+
+		//!time of the last spike of each neuron
+		array<double, NN> lastSpike_;
+
+		//!number of spikes of each neuron
+		array<size_t, NN> counts_;
+
+		//!buffers of the spikes recieved by each neuron
+		array< array<double, D+1>, NN > buffers_;
+
+		//!connection map stored row by row, like in NetworkT
+		array<int, NN+1> offsets_;
+		array<int, SYNAPSES> targets_;
+
+		//!spikes of the simulation as (time, neuron) in the order they occur
+		vector< pair<double, int> > spikes_;
+
+		//!external current applied on every neuron
+		double Iext_;
+
+		//!local clock of the network
+		unsigned int netClock_;
+
+		//!random generator used for the connections and the external noise
+		mt19937 gen_;
+
+		//!distribution of the number of external spikes recieved in a step
+		poisson_distribution<int> poisson_;
+
+	public:
+
+	//////////////////////////////
+	//                          //
+	//		  constructor		//
+	//                          //
+	//////////////////////////////
+
+		/*!
+		 * @brief initialise the network and draw its connections
+		 *
+		 * @param unsigned int seed seed of the random generator
+		 */
+		explicit FixedNetwork(unsigned int seed)
+				:Iext_(0.0),
+				 netClock_(0),
+				 gen_(seed),
+				 poisson_(V_ext*CE)
+		{
+			for (int i(0); i<NN; ++i)
+			{
+				Model::init(state_[i]);
+				refractory_[i] = false;
+				clocks_[i] = 0;
+				lastSpike_[i] = 0.0;
+				counts_[i] = 0;
+				buffers_[i].fill(0.0);
+			}
+
+			/*
+			 * the connections are drawn exactly like in NetworkT: the
+			 * first pass counts the post-synaptic neurons of each neuron,
+			 * the second one writes them in their row
+			 */
+			offsets_.fill(0);
+			array<int, NN> fill;
+			mt19937 first(gen_);
+
+			for (int pass(0); pass<2; ++pass)
+			{
+				gen_ = first;
+
+				drawConnections(gen_, NE, NN, CE, CI, [&](int pre, int post)
+				{
+					if(pass == 0)
+					{
+						++offsets_[pre+1];
+					}
+					else
+					{
+						targets_[fill[pre]++] = post;
+					}
+				});
+
+				if(pass == 0)
+				{
+					for (int i(0); i<NN; ++i)
+					{
+						offsets_[i+1] += offsets_[i];
+						fill[i] = offsets_[i];
+					}
+				}
+			}
+		}
+
+	//////////////////////////////
+	//                          //
+	//			Getters			//
+	//                          //
+	//////////////////////////////
+
+		/*!
+		 * @brief get the current step of the network
+		 */
+		unsigned int getClock() const
+		{
+			return netClock_;
+		}
+
+		/*!
+		 * @brief get the membrane potential of a neuron
+		 */
+		double getMembranePotential(int i) const
+		{
+			return Model::potential(state_[i]);
+		}
+
+		/*!
+		 * @brief get the number of spikes of a neuron
+		 */
+		size_t getNumberOfSpike(int i) const
+		{
+			return counts_[i];
+		}
+
+		/*!
+		 * @brief get the total number of spikes of the network
+		 */
+		size_t getNumberOfSpike() const
+		{
+			return spikes_.size();
+		}
+
+		/*!
+		 * @brief get the connection map of the network
+		 *
+		 * @return vector< vector<int> > the post-synaptic neurons of each neuron
+		 */
+		vector< vector<int> > getConnectionMap() const
+		{
+			vector< vector<int> > map(NN);
+
+			for (int i(0); i<NN; ++i)
+			{
+				map[i].assign(targets_.begin()+offsets_[i], targets_.begin()+offsets_[i+1]);
+			}
+
+			return map;
+		}
+
+		/*!
+		 * @brief get the spike times of every neuron of the network
+		 *
+		 * @return vector< vector<double> > spike times of each neuron
+		 */
+		vector< vector<double> > getSpikeTrains() const
+		{
+			vector< vector<double> > trains(NN);
+
+			for (int i(0); i<NN; ++i)
+			{
+				trains[i].reserve(counts_[i]);
+			}
+			for (size_t k(0); k<spikes_.size(); ++k)
+			{
+				trains[spikes_[k].second].push_back(spikes_[k].first);
+			}
+
+			return trains;
+		}
+
+	//////////////////////////////
+	//                          //
+	//			Setters			//
+	//                          //
+	//////////////////////////////
+
+		/*!
+		 * @brief set the external current applied on every neuron
+		 */
+		void setCurrent(double I)
+		{
+			Iext_ = I;
+		}
+
+	//////////////////////////////
+	//                          //
+	//		  Simulation		//
+	//                          //
+	//////////////////////////////
+
+		/*!
+		 * @brief run the simulation until t=t_stop
+		 */
+		void runSimulation(unsigned int t_stop)
+		{
+			while(netClock_ < t_stop)
+			{
+				update();
+				++netClock_;
+			}
+		}
+
+		/*!
+		 * @brief update every neuron for one time step h and deliver
+		 * 		  their spikes
+		 */
+		void update()
+		{
+			for (int i(0); i<NN; ++i)
+			{
+				//external random noise recieved by the neuron during this step
+				//(drawn only if it integrates it, like in NetworkT)
+				double Jext = integrates<Model>(state_[i], refractory_[i]) ? poisson_(gen_)*Je : 0.0;
+
+				if(step(i, Jext))
+				{
+					double J = (i < NE) ? Je : Ji;
+
+					for (int j(offsets_[i]); j<offsets_[i+1]; ++j)
+					{
+						buffers_[targets_[j]][(netClock_+D) % (D+1)] += J;
+					}
+				}
+			}
+		}
+
+	private:
+
+		/*!
+		 * @brief update a neuron with stepModel, like NeuronT::step
+		 *
+		 * @return bool true if the neuron spikes
+		 */
+		bool step(int i, double Jext)
+		{
+			double& slot = buffers_[i][clocks_[i] % (D+1)];
+
+			if(stepModel<Model>(state_[i], refractory_[i], clocks_[i], lastSpike_[i], Iext_, Jext + slot))
+			{
+				lastSpike_[i] = clocks_[i];
+				++counts_[i];
+				spikes_.push_back(make_pair(lastSpike_[i], i));
+
+				return true;
+			}
+
+			slot = 0;
+			++clocks_[i];
+
+			return false;
+		}
+};
+
+template <int NE, int NI, class Model>
+constexpr int FixedNetwork<NE, NI, Model>::NN;
+
+template <int NE, int NI, class Model>
+constexpr int FixedNetwork<NE, NI, Model>::CE;
+
+template <int NE, int NI, class Model>
+constexpr int FixedNetwork<NE, NI, Model>::CI;
+
+template <int NE, int NI, class Model>
+constexpr int FixedNetwork<NE, NI, Model>::SYNAPSES;
+
+#endif
@@ -1,6 +1,8 @@
 #include "network.hpp"
+#include "progress.hpp"
 
 #include <iostream>
+#include <random>
 
 /*
  * main programm
@@ -24,10 +26,17 @@
  */
 int main()
 {
-	Network net;
+	random_device rd;
+	Network net(rd(), TRANSPARENT_HUGE);
+	
+	//the progress is written every 10s, and at once on kill -USR1 <pid>
+	ProgressReporter progress(net);
+	ProgressReporter::enableSignal();
 
 	net.runSimulation(10000);
 	
+	cout << "memory footprint: " << net.getFootprint()/(1024*1024) << "MB" << endl;
+	
 	net.printSpikeTimes();
 
 	return 0;
@@ -0,0 +1,159 @@
+#ifndef model_HPP
+#define model_HPP
+
+#include "constant.hpp"
+
+#include <cmath>
+
+/*
+ * neuron model policies
+ *
+ * a model policy tells a neuron how its state is laid out, how this state
+ * evolves during one time step h (propagator) and when it spikes
+ * (threshold logic). Neuron and Network are templated on it, so every
+ * model gets its own fully inlined kernel without any runtime dispatch.
+ *
+ * a policy has to provide:
+ * 	- a type State
+ * 	- void init(State&)								initial state
+ * 	- double potential(const State&)				membrane potential
+ * 	- void setPotential(State&, double)
+ * 	- void integrate(State&, double Iext, double J)	state at t+h
+ * 	- bool threshold(const State&)					true if it spikes
+ * 	- void reset(State&)							state after a spike
+ *
+ * to add a new model write its policy here and add its explicit
+ * instantiations at the end of neuron.cpp and network.cpp
+ *
+ * the refractory period and the spikes are handled the same way for every
+ * model by stepModel, at the end of this file
+ */
+
+/*!
+ * @brief leaky integrate-and-fire model (default policy)
+ *
+ * the membrane potential is the only state variable, the input J coming
+ * from the buffer and the external noise is added directly to it
+ */
+struct LIF
+{
+	//!state of a LIF neuron: its membrane potential
+	struct State
+	{
+		double V;
+	};
+
+	/*!
+	 * @brief initialise the state at the reset potential
+	 */
+	static void init(State& s)
+	{
+		s.V = V_reset;
+	}
+
+	/*!
+	 * @brief get the membrane potential of the state
+	 */
+	static double potential(const State& s)
+	{
+		return s.V;
+	}
+
+	/*!
+	 * @brief set the membrane potential of the state
+	 */
+	static void setPotential(State& s, double V)
+	{
+		s.V = V;
+	}
+
+	/*!
+	 * @brief exact propagator of the membrane equation over a step h
+	 */
+	static double propagator()
+	{
+		return exp(-h/tau);
+	}
+
+	/*!
+	 * @brief compute the membrane potential at time t+h
+	 *
+	 * @param double Iext the external electric current applied on the neuron
+	 * @param double J the input recieved from the other neurons
+	 */
+	static void integrate(State& s, double Iext, double J)
+	{
+		double c = propagator();
+		s.V = s.V*c + Iext*R*(1-c) + J;
+	}
+
+	/*!
+	 * @brief tells if the state reached the treshold potential
+	 */
+	static bool threshold(const State& s)
+	{
+		return s.V >= V_tresh;
+	}
+
+	/*!
+	 * @brief put the state back at the reset potential after a spike
+	 */
+	static void reset(State& s)
+	{
+		s.V = V_reset;
+	}
+};
+
+/*!
+ * @brief tells if a neuron integrates its input during its next step (it
+ * 		  is neither refractory nor above the threshold)
+ */
+template <class Model>
+inline bool integrates(const typename Model::State& s, bool refractory)
+{
+	return !refractory and !Model::threshold(s);
+}
+
+/*!
+ * @brief one step of a neuron, shared by NeuronT::step and FixedNetwork
+ *
+ * a refractory neuron stays still until tau_rp after its last spike, a
+ * neuron under the threshold integrates its input and a neuron above it
+ * is reset and becomes refractory
+ *
+ * @param bool refractory tells if the neuron is refractory (updated)
+ * @param double clock step of the neuron
+ * @param double lastSpike time of its last spike (read if refractory)
+ * @param double Iext the external electric current applied on the neuron
+ * @param double J the input recieved during this step
+ *
+ * @return bool true if the neuron spikes: the caller records the spike
+ * 		   and neither clears its buffer nor moves its clock
+ */
+template <class Model>
+inline bool stepModel(typename Model::State& s, bool& refractory, double clock,
+					  double lastSpike, double Iext, double J)
+{
+	if(refractory)
+	{
+		if(clock >= lastSpike+tau_rp)
+		{
+			refractory = false;
+		}
+	}
+	else if(integrates<Model>(s, refractory))
+	{
+		Model::integrate(s, Iext, J);
+	}
+	else
+	{
+		Model::reset(s);
+		refractory = true;
+
+		return true;
+	}
+
+	return false;
+}
+
+#endif
@@ -1,22 +1,127 @@
 #include "network.hpp"
+#include "spikestore.hpp"
+#include "spiketext.hpp"
+#include "wiring.hpp"
 
 #include <iostream>
 #include <fstream>
 #include <random>
 #include <cassert>
+#include <algorithm>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cmath>
+#include <unistd.h>
 
 using namespace std;
 
+//size of the neurons of a tile of the batched delivery when the size of
+//the L2 cache is unknown
+static const size_t tileBytes(256*1024);
+
+/*
+ * barrier used by the workers of the pull mode to wait for each other
+ * between the update and the delivery of a step
+ */
+class Barrier
+{
+	private:
+	
+		mutex mutex_;
+		condition_variable cv_;
+		unsigned int count_;
+		unsigned int waiting_;
+		unsigned int generation_;
+		
+	public:
+	
+		Barrier(unsigned int count)
+				:count_(count), waiting_(0), generation_(0)
+		{}
+		
+		void wait()
+		{
+			unique_lock<mutex> lock(mutex_);
+			unsigned int gen = generation_;
+			
+			if(++waiting_ == count_)
+			{
+				waiting_ = 0;
+				++generation_;
+				cv_.notify_all();
+			}
+			else
+			{
+				cv_.wait(lock, [&]{ return gen != generation_; });
+			}
+		}
+};
+
+/*
+ * threads of the pull mode parked between two runs: the caller of
+ * runSimulation is the worker of the first block, the others wait on the
+ * barrier for the steps of the next run
+ */
+template <class Model>
+struct NetworkT<Model>::Workers
+{
+	Barrier barrier;
+	vector<thread> threads;
+	
+	//!steps of the current run, quit tells the threads to end
+	unsigned int start, stop;
+	bool quit;
+	
+	Workers(unsigned int count)
+			:barrier(count), start(0), stop(0), quit(false)
+	{}
+};
+
 	//////////////////////////////
 	//                          //
 	// constructor & destructor //
 	//                          //
 	//////////////////////////////
 	
-Network::Network()
-		:neurons_(), 
-		 connectionMap_(N, vector<int>()),
-		 netClock_(0)
+template <class Model>
+NetworkT<Model>::NetworkT()
+		:NetworkT(random_device()())
+{}
+
+template <class Model>
+NetworkT<Model>::NetworkT(unsigned int seed, page_mode pages)
+		:arena_(pages),
+		 neurons_(ArenaAllocator< NeuronT<Model> >(&arena_)), 
+		 offsets_(N+1, 0, ArenaAllocator<int>(&arena_)),
+		 targets_(ArenaAllocator<int>(&arena_)),
+		 ends_(ArenaAllocator<int>(&arena_)),
+		 slack_(max(Ctot/32, 4)),
+		 inOffsets_(ArenaAllocator<int>(&arena_)),
+		 sources_(ArenaAllocator<int>(&arena_)),
+		 incomingValid_(false),
+		 inSynapses_(ArenaAllocator<int>(&arena_)),
+		 plastic_(false),
+		 weights_(ArenaAllocator<float>(&arena_)),
+		 traces_(ArenaAllocator<Trace>(&arena_)),
+		 Aplus_(A_plus),
+		 Aminus_(A_minus),
+		 Jmax_(J_max),
+		 netClock_(0),
+		 gen_(seed),
+		 poisson_(V_ext*Ce),
+		 noise_(true),
+		 delivery_(PUSH),
+		 Iext_(N, 0.0, ArenaAllocator<double>(&arena_)),
+		 statusClock_(0),
+		 statusStop_(0),
+		 statusSpikes_(0),
+		 stepSpikes_(0),
+		 spikeStream_(nullptr),
+		 inputStream_(nullptr),
+		 lockstep_(false),
+		 inputReady_(0),
+		 Iinput_(ArenaAllocator<double>(&arena_))
 {	
 	/*!
 	 * by default ou network consist in a number N of neurons stocked in the constant file 
@@ -26,78 +131,92 @@ Network::Network()
 	 * the 4N/5 first elements are excitatory neurons
 	 * the N/5 left are inhibitory neurons
 	 */
+	neurons_.reserve(N);
 	
 	//adding the exitatory neuron		
 	for(int i(0); i<Ne ; ++i)
 	{
-		neurons_.push_back(Neuron(E));
+		neurons_.push_back(NeuronT<Model>(E, &arena_));
 	}
 	//adding the inhibitory neurons
 	for(int i(0); i<Ni; ++i)
 	{
-		neurons_.push_back(Neuron(I));
+		neurons_.push_back(NeuronT<Model>(I, &arena_));
 	}
  
     /*!
      * we fill our connection map the following way :
      * 
      * each neuron should recieve a certain number of connection from
-     * excitatory(Ce) and inhibitory(Ci) neurons.
+     * excitatory(Ce) and inhibitory(Ci) neurons (see wiring.hpp).
      * Our map telling us for a neuron which are its POST synaptic
      * neurons we have to place randomly each neuron in a way that it 
      * occure the right amount of time in our map
+     * 
+     * the connections are drawn twice with the same random numbers: the
+     * first pass counts the post-synaptic neurons of each neuron (to
+     * know where its row begins), the second one writes them in their row
      */
-    for (size_t i(0); i<N; ++i)
-    {
-		/*!
-		 * selection of the exitatory connection:
-		 * 
-		 * we assign it randomly to Ce excitatory neurons (other than 
-		 * himself)
-		 */
-		for (int E(0); E < Ce; ++E) 
-		{
-			unsigned int r(0);
+	mt19937 first(gen_);
+	vector<int> fill;
 	
-			static random_device rd; 
-			static mt19937 gen(rd());
-			static uniform_int_distribution<> dis(0,Ne-1);
-
-			do
+	for (int pass(0); pass<2; ++pass)
+	{
+		gen_ = first;
+		
+		drawConnections(gen_, Ne, N, Ce, Ci, [&](int pre, int post)
+		{
+			if(pass == 0)
 			{
-				r = dis(gen);
-			}while(r == i);
-			
-			connectionMap_[r].push_back(i);
-		}
-		/*!
-		 * selection of the inhibitory connection:
-		 * 
-		 * we assign it randomly to Ci inhibitory neurons (other than 
-		 * himself)
-		 */
-		for (int I(0); I < Ci; ++I) 
+				++offsets_[pre+1];
+			}
+			else
+			{
+				targets_[fill[pre]++] = post;
+			}
+		});
+		
+		if(pass == 0)
 		{
-			unsigned int r(0);
-	
-			static random_device rd; 
-			static mt19937 gen(rd());
-			static uniform_int_distribution<> dis(Ne,N-1);
-
-			do
+			for (size_t i(0); i<N; ++i)
 			{
-				r = dis(gen);
-			}while(r == i);
-			
-			connectionMap_[r].push_back(i);
-		}	
+				offsets_[i+1] += offsets_[i];
+			}
+			targets_.resize(offsets_[N]);
+			fill.assign(offsets_.begin(), offsets_.end()-1);
+		}
 	}
+	
+	//the rows are full, the slack is only added when the map is rewired
+	ends_.assign(offsets_.begin()+1, offsets_.end());
 }
 
-Network::~Network()
+template <class Model>
+NetworkT<Model>::Block::Block(Arena* arena, unsigned int seed)
+		:begin(0),
+		 end(0),
+		 offsets(ArenaAllocator<int>(arena)),
+		 targets(ArenaAllocator<int>(arena)),
+		 gen(seed),
+		 poisson(V_ext*Ce)
+{}
+
+template <class Model>
+NetworkT<Model>::~NetworkT()
 {
+	stopWorkers();
+	blocks_.clear();
+	Iext_.clear();
+	Iinput_.clear();
+	inOffsets_.clear();
+	sources_.clear();
+	inSynapses_.clear();
+	weights_.clear();
+	traces_.clear();
 	neurons_.clear();
-	connectionMap_.clear();
+	offsets_.clear();
+	targets_.clear();
+	ends_.clear();
 }
 
 	//////////////////////////////
@@ -106,14 +225,117 @@ Network::~Network()
 	//                          //
 	//////////////////////////////
 	
-vector<Neuron> Network::getNeurons()
+template <class Model>
+vector< NeuronT<Model> > NetworkT<Model>::getNeurons()
 {
-	return neurons_;
+	return vector< NeuronT<Model> >(neurons_.begin(), neurons_.end());
 }	
 
-vector< vector<int> > Network::getConnectionMap()
+template <class Model>
+vector< vector<int> > NetworkT<Model>::getConnectionMap()
+{
+	vector< vector<int> > map(N);
+	
+	for (size_t i(0); i<N; ++i)
+	{
+		map[i].assign(targets_.begin()+offsets_[i], targets_.begin()+ends_[i]);
+	}
+	
+	return map;
+}
+
+template <class Model>
+unsigned int NetworkT<Model>::getClock() const
+{
+	return netClock_;
+}
+
+template <class Model>
+size_t NetworkT<Model>::getNumberOfSpike() const
+{
+	size_t spikes(0);
+	
+	for (size_t i(0); i<N; ++i)
+	{
+		spikes += neurons_[i].getNumberOfSpike();
+	}
+	
+	return spikes;
+}
+
+template <class Model>
+typename NetworkT<Model>::Status NetworkT<Model>::getStatus() const
+{
+	Status status;
+	
+	status.clock = statusClock_.load(memory_order_relaxed);
+	status.stop = statusStop_.load(memory_order_relaxed);
+	status.spikes = statusSpikes_.load(memory_order_relaxed);
+	status.footprint = arena_.getFootprint();
+	
+	return status;
+}
+
+template <class Model>
+size_t NetworkT<Model>::getFootprint() const
 {
-	return connectionMap_;
+	return arena_.getFootprint();
+}
+
+template <class Model>
+vector<int> NetworkT<Model>::getPresynaptic(unsigned int post)
+{
+	if(post >= N)
+	{
+		return vector<int>();
+	}
+	if(!incomingValid_)
+	{
+		buildIncoming();
+	}
+	return vector<int>(sources_.begin()+inOffsets_[post], sources_.begin()+inOffsets_[post+1]);
+}
+
+template <class Model>
+int NetworkT<Model>::getInDegree(unsigned int post)
+{
+	if(post >= N)
+	{
+		return 0;
+	}
+	if(!incomingValid_)
+	{
+		buildIncoming();
+	}
+	return inOffsets_[post+1]-inOffsets_[post];
+}
+
+template <class Model>
+vector<double> NetworkT<Model>::getWeights(unsigned int pre) const
+{
+	if(pre >= N)
+	{
+		return vector<double>();
+	}
+	if(plastic_ and pre < size_t(Ne))
+	{
+		return vector<double>(weights_.begin()+offsets_[pre], weights_.begin()+ends_[pre]);
+	}
+	return vector<double>(ends_[pre]-offsets_[pre], (pre < size_t(Ne)) ? Je : Ji);
+}
+
+template <class Model>
+vector< vector<double> > NetworkT<Model>::getSpikeTrains() const
+{
+	vector< vector<double> > spikes;
+	spikes.reserve(N);
+	
+	for (size_t i(0); i<N; ++i)
+	{
+		spikes.push_back(neurons_[i].getSpikeTimes());
+	}
+	
+	return spikes;
 }
 
 	//////////////////////////////
@@ -122,7 +344,8 @@ vector< vector<int> > Network::getConnectionMap()
 	//                          //
 	//////////////////////////////
 	
-void Network::setManualConnection (unsigned int pre, unsigned int post)
+template <class Model>
+void NetworkT<Model>::setManualConnection (unsigned int pre, unsigned int post)
 {
 	if((pre>=N) or (post>=N))
 	{
@@ -132,153 +355,1357 @@ void Network::setManualConnection (unsigned int pre, unsigned int post)
 	}
 	else
 	{
-		connectionMap_[pre].push_back(post);
-		
+		//the connection is added at the end of the row of pre
+		Synapse synapse = {pre, post};
+		addConnections(vector<Synapse>(1, synapse));
+	}
+}
+
+template <class Model>
+void NetworkT<Model>::setExternalNoise(bool enabled)
+{
+	noise_ = enabled;
+}
+
+template <class Model>
+size_t NetworkT<Model>::getNumberOfConnections() const
+{
+	size_t synapses(0);
+	
+	for (size_t i(0); i<N; ++i)
+	{
+		synapses += ends_[i]-offsets_[i];
+	}
+	
+	return synapses;
+}
+
+template <class Model>
+void NetworkT<Model>::enablePlasticity(double Aplus, double Aminus, double Jmax)
+{
+	if(delivery_ != PUSH)
+	{
+		cerr << "ERROR: plasticity needs the push delivery" << endl;
+		return;
+	}
+	
+	Aplus_ = Aplus;
+	Aminus_ = Aminus;
+	Jmax_ = Jmax;
+	
+	if(plastic_)
+	{
+		return;
+	}
+	plastic_ = true;
+	
+	//every plastic synapse starts with the static weight
+	weights_.assign(offsets_[Ne], Je);
+	
+	Trace empty = {0, 0.0, 0.0};
+	traces_.assign(Ne, empty);
+	
+	//the traces are neglected after 10 time constants
+	decayPre_.resize(10*tau_plus);
+	decayPost_.resize(10*tau_minus);
+	for (size_t k(0); k<decayPre_.size(); ++k)
+	{
+		decayPre_[k] = exp(-(k*h)/tau_plus);
+	}
+	for (size_t k(0); k<decayPost_.size(); ++k)
+	{
+		decayPost_[k] = exp(-(k*h)/tau_minus);
 	}
+	
+	//the transposed map gives the incoming synapses to potentiate
+	buildIncoming();
 }
 
 	//////////////////////////////
 	//                          //
-	//			Display			//
+	//		   Rewiring			//
 	//                          //
 	//////////////////////////////
 
-void Network::displayNeurons()
+template <class Model>
+size_t NetworkT<Model>::addConnections(const vector<Synapse>& synapses)
 {
-	cout << "---Neurons---" << endl << endl;
+	/*
+	 * the connections are counted row by row first, the map is laid out
+	 * again only if one of the rows has not enough free places
+	 */
+	vector<int> extra(N, 0);
+	bool full(false);
 	
-	for (size_t i(0); i<N; ++i)
+	for (size_t k(0); k<synapses.size(); ++k)
 	{
-		cout << "N" << i << endl;
+		const Synapse& s = synapses[k];
+		if(s.pre >= N or s.post >= N)
+		{
+			cerr << "ERROR: connection out of range" << endl;
+			return 0;
+		}
+		
+		++extra[s.pre];
+		full = full or (ends_[s.pre] + extra[s.pre] > offsets_[s.pre+1]);
+	}
+	
+	if(full)
+	{
+		layout(slack_, extra);
 	}
+	
+	for (size_t k(0); k<synapses.size(); ++k)
+	{
+		const Synapse& s = synapses[k];
 		
-	cout << endl << endl;
+		if(plastic_ and s.pre < size_t(Ne))
+		{
+			weights_[ends_[s.pre]] = Je;
+		}
+		targets_[ends_[s.pre]++] = s.post;
+	}
+	
+	rewired();
+	
+	return synapses.size();
 }
 
-void Network::displayConnectionMap()
+template <class Model>
+size_t NetworkT<Model>::removeConnections(const vector<Synapse>& synapses)
 {
-	cout << "---Connection Map---" << endl << endl;
-	cout << "   =========================================" << endl;
-	for (size_t i(0); i<N; ++i)
+	size_t removed(0);
+	
+	for (size_t k(0); k<synapses.size(); ++k)
 	{
-		cout << "N" << i << "	";
-		for (size_t j(0); j<connectionMap_[i].size(); ++j)
+		const Synapse& s = synapses[k];
+		if(s.pre >= N)
 		{
-			cout << connectionMap_[i][j] << " ";
+			continue;
+		}
+		
+		/*
+		 * the last connection of the row takes the place of the one
+		 * removed, the order of the row is not kept
+		 */
+		for (int j(offsets_[s.pre]); j<ends_[s.pre]; ++j)
+		{
+			if(targets_[j] == int(s.post))
+			{
+				int last = --ends_[s.pre];
+				targets_[j] = targets_[last];
+				if(plastic_ and s.pre < size_t(Ne))
+				{
+					weights_[j] = weights_[last];
+				}
+				++removed;
+				break;
+			}
 		}
-		cout << endl;
-		cout << "   -----------------------------------------" << endl;
 	}
-	cout << "   =========================================" << endl;
-	cout << endl << endl;
+	
+	/*
+	 * the places freed are compacted once they are more than the slack
+	 * of the rows plus an eighth of the connections
+	 */
+	size_t used = getNumberOfConnections();
+	if(targets_.size() - used > N*slack_ + used/8)
+	{
+		layout(slack_, vector<int>(N, 0));
+	}
+	
+	rewired();
+	
+	return removed;
 }
 
-void Network::displaySpikeTimes()
+template <class Model>
+size_t NetworkT<Model>::rewireConnections(const vector<Rewiring>& rewirings)
 {
-	cout << endl << endl << "---spikes---" << endl << endl;
+	size_t moved(0);
 	
-	for (size_t i(0); i<N; ++i)
+	for (size_t k(0); k<rewirings.size(); ++k)
 	{
-		if(neurons_[i].getNumberOfSpike() != 0)
+		const Rewiring& r = rewirings[k];
+		if(r.pre >= N or r.to >= N)
 		{
-			cout << endl << "---N"<< i <<"---" << endl << neurons_[i].getNumberOfSpike() << " spikes occured at times: " << endl;
-			for(size_t j = 0; j < neurons_[i].getSpikeTimes().size(); ++j)
+			continue;
+		}
+		
+		//the connection keeps its place in the row
+		for (int j(offsets_[r.pre]); j<ends_[r.pre]; ++j)
+		{
+			if(targets_[j] == int(r.from))
 			{
-				cout << "t = " << (neurons_[i].getSpikeTimes()[j])/10 << "ms" << endl;
+				targets_[j] = r.to;
+				if(plastic_ and r.pre < size_t(Ne))
+				{
+					weights_[j] = Je;
+				}
+				++moved;
+				break;
 			}
-			cout << endl << endl;
 		}
 	}
+	
+	rewired();
+	
+	return moved;
 }
 
-void Network::displaySimulation()
+template <class Model>
+void NetworkT<Model>::setRowSlack(size_t slack)
 {
-	displayNeurons();
-	displayConnectionMap();
-	displaySpikeTimes();
+	slack_ = slack;
 }
 
-	//////////////////////////////
-	//                          //
-	//			Print			//
-	//                          //
-	//////////////////////////////
-	
-void Network::printSpikeTimes()
+template <class Model>
+void NetworkT<Model>::compactConnections()
 {
-	ofstream data;
-	data.open("data_neuro.txt");
+	layout(0, vector<int>(N, 0));
+	rewired();
+}
+
+template <class Model>
+void NetworkT<Model>::layout(size_t slack, const vector<int>& extra)
+{
+	/*
+	 * the rows are copied aside and written back at their new place, the
+	 * arrays of the arena keep their memory when they do not grow
+	 */
+	vector<int> targets(targets_.begin(), targets_.end());
+	vector<float> weights(weights_.begin(), weights_.end());
+	vector<int> offsets(offsets_.begin(), offsets_.end());
 	
-	if(data.fail())
+	for (size_t i(0); i<N; ++i)
 	{
-		cerr << "Error while opening the file" << endl;
-		assert(data.fail());
+		int size = ends_[i]-offsets[i];
+		offsets_[i+1] = offsets_[i] + size + extra[i] + slack;
 	}
-	else
+	
+	/*
+	 * the arrays grow by half of their size at least, so that a long
+	 * rewiring only reallocates them a few times; when they shrink they
+	 * keep their memory for the next layouts
+	 */
+	size_t size = offsets_[N];
+	if(size > targets_.capacity())
+	{
+		targets_.reserve(max(size, targets_.capacity() + targets_.capacity()/2));
+	}
+	targets_.resize(size);
+	
+	if(plastic_)
 	{
-		for(int i(0); i<N; ++i)
+		size = offsets_[Ne];
+		if(size > weights_.capacity())
 		{
-			for(size_t j(0); j<neurons_[i].getSpikeTimes().size(); ++j)
-			{
-				data << (neurons_[i].getSpikeTimes()[j])/100 << "\t" << i << "\n";
-			}
+			weights_.reserve(max(size, weights_.capacity() + weights_.capacity()/2));
 		}
+		weights_.resize(size);
 	}
-}	
+	
+	for (size_t i(0); i<N; ++i)
+	{
+		int size = ends_[i]-offsets[i];
+		
+		copy(targets.begin()+offsets[i], targets.begin()+offsets[i]+size, targets_.begin()+offsets_[i]);
+		if(plastic_ and i < size_t(Ne))
+		{
+			copy(weights.begin()+offsets[i], weights.begin()+offsets[i]+size, weights_.begin()+offsets_[i]);
+		}
+		ends_[i] = offsets_[i]+size;
+	}
+}
+
+template <class Model>
+void NetworkT<Model>::rewired()
+{
+	incomingValid_ = false;
+	
+	if(delivery_ != PUSH)
+	{
+		connectBlocks();
+	}
+}
 
 	//////////////////////////////
 	//                          //
-	//		  Simulation		//
+	//		   Stimuli			//
 	//                          //
 	//////////////////////////////
 
-void Network::runSimulation(unsigned int t_stop)
-{		
-		while(netClock_ < t_stop)
+template <class Model>
+void NetworkT<Model>::addStimulus(const Stimulus& stimulus, const vector<int>& neurons)
+{
+	Injection inj = {stimulus, vector<int>()};
+	
+	for (size_t k(0); k<neurons.size(); ++k)
+	{
+		if(neurons[k] < 0 or neurons[k] >= N)
 		{
-			
-			update();
-		
-			++netClock_;
+			cerr << "ERROR: stimulus out of range" << endl;
+			return;
 		}
+	}
+	
+	inj.neurons = neurons;
+	sort(inj.neurons.begin(), inj.neurons.end());
+	
+	injections_.push_back(inj);
 }
 
-void Network::update()
+template <class Model>
+void NetworkT<Model>::addStimulus(const Stimulus& stimulus, unsigned int first, unsigned int last)
 {
-	for (size_t i(0); i<N; ++i)
+	vector<int> neurons;
+	for (unsigned int n(first); n<last; ++n)
 	{
-		//check for each neuron if it spiked during this update
-		if(neurons_[i].update(0.0, true))
-		{
-			/*
-			 * if yes we transmit the corresponding electrical imput
-			 * (Je = 0.1 if the neuron is excitatory, Ji =-0.5 if it is
-			 * inhibitory) to all its post synaptic neurons
-			 */
-			for(size_t j(0); j<connectionMap_[i].size(); ++j)
-			{
-				int post = connectionMap_[i][j]; 
-
-				if(neurons_[i].isExcitatory())
-				{
-					/*
-					 * the electrical imput is written in the buffer of
-					 * the post synaptic neuron with a delay D=15ms
-					 */
-					neurons_[post].setBufferAt(netClock_+D, Je);
-				}
-				else
-				{
-					neurons_[post].setBufferAt(netClock_+D, Ji);
-				}
-			}
-		}
+		neurons.push_back(n);
 	}
+	addStimulus(stimulus, neurons);
 }
 
+	//////////////////////////////
+	//                          //
+	//			Probes			//
+	//                          //
+	//////////////////////////////
 
+template <class Model>
+NetworkT<Model>::Probe::Probe(Arena* arena, size_t n, unsigned int dt, unsigned int t0)
+		:neuron(n),
+		 interval(dt),
+		 start(t0),
+		 V(ArenaAllocator<double>(arena)),
+		 input(ArenaAllocator<double>(arena))
+{}
 
+template <class Model>
+size_t NetworkT<Model>::addProbe(unsigned int neuron, unsigned int interval)
+{
+	if((neuron>=N) or (interval==0))
+	{
+		cerr << "ERROR: probe out of range" << endl;
+		return probes_.size();
+	}
+	
+	probes_.push_back(Probe(&arena_, neuron, interval, netClock_));
+	
+	//the probes are kept sorted by neuron for the update
+	size_t id = probes_.size()-1;
+	vector<size_t>::iterator k = upper_bound(probeOrder_.begin(), probeOrder_.end(), id,
+		[this](size_t a, size_t b){ return probes_[a].neuron < probes_[b].neuron; });
+	probeOrder_.insert(k, id);
+	
+	return id;
+}
 
+template <class Model>
+vector<double> NetworkT<Model>::getProbePotential(size_t probe) const
+{
+	if(probe >= probes_.size())
+	{
+		return vector<double>();
+	}
+	return vector<double>(probes_[probe].V.begin(), probes_[probe].V.end());
+}
+
+template <class Model>
+vector<double> NetworkT<Model>::getProbeInput(size_t probe) const
+{
+	if(probe >= probes_.size())
+	{
+		return vector<double>();
+	}
+	return vector<double>(probes_[probe].input.begin(), probes_[probe].input.end());
+}
+
+template <class Model>
+vector<double> NetworkT<Model>::getProbeTimes(size_t probe) const
+{
+	vector<double> times;
+	
+	if(probe < probes_.size())
+	{
+		const Probe& p = probes_[probe];
+		for (size_t k(0); k<p.V.size(); ++k)
+		{
+			times.push_back(p.start + k*p.interval);
+		}
+	}
+	return times;
+}
+
+	//////////////////////////////
+	//                          //
+	//			Display			//
+	//                          //
+	//////////////////////////////
+
+template <class Model>
+void NetworkT<Model>::displayNeurons()
+{
+	cout << "---Neurons---" << endl << endl;
+	
+	for (size_t i(0); i<N; ++i)
+	{
+		cout << "N" << i << endl;
+	}
+		
+	cout << endl << endl;
+}
+
+template <class Model>
+void NetworkT<Model>::displayConnectionMap()
+{
+	cout << "---Connection Map---" << endl << endl;
+	cout << "   =========================================" << endl;
+	for (size_t i(0); i<N; ++i)
+	{
+		cout << "N" << i << "	";
+		for (int j(offsets_[i]); j<ends_[i]; ++j)
+		{
+			cout << targets_[j] << " ";
+		}
+		cout << endl;
+		cout << "   -----------------------------------------" << endl;
+	}
+	cout << "   =========================================" << endl;
+	cout << endl << endl;
+}
+
+template <class Model>
+void NetworkT<Model>::displaySpikeTimes()
+{
+	cout << endl << endl << "---spikes---" << endl << endl;
+	
+	for (size_t i(0); i<N; ++i)
+	{
+		if(neurons_[i].getNumberOfSpike() != 0)
+		{
+			cout << endl << "---N"<< i <<"---" << endl << neurons_[i].getNumberOfSpike() << " spikes occured at times: " << endl;
+			for(size_t j = 0; j < neurons_[i].getSpikeTimes().size(); ++j)
+			{
+				cout << "t = " << (neurons_[i].getSpikeTimes()[j])/10 << "ms" << endl;
+			}
+			cout << endl << endl;
+		}
+	}
+}
+
+template <class Model>
+void NetworkT<Model>::displaySimulation()
+{
+	displayNeurons();
+	displayConnectionMap();
+	displaySpikeTimes();
+}
+
+	//////////////////////////////
+	//                          //
+	//			Print			//
+	//                          //
+	//////////////////////////////
+	
+template <class Model>
+void NetworkT<Model>::printSpikeTimes(const string& file, unsigned int workers)
+{
+	ofstream data;
+	data.open(file.c_str(), ios::binary);
+	
+	if(data.fail())
+	{
+		cerr << "Error while opening the file" << endl;
+		assert(data.fail());
+		return;
+	}
+	
+	if(workers == 0)
+	{
+		workers = 1;
+	}
+	if(workers > N)
+	{
+		workers = N;
+	}
+	
+	size_t size = (N+workers-1)/workers;
+	
+	/*
+	 * each worker formats the lines of its range of neurons in its own
+	 * buffer, large enough for the longest lines
+	 */
+	vector< vector<char> > parts(workers);
+	
+	auto format = [&](size_t w)
+	{
+		size_t begin = min(w*size, size_t(N)),
+			   end = min((w+1)*size, size_t(N));
+		
+		size_t spikes(0);
+		for (size_t i(begin); i<end; ++i)
+		{
+			spikes += neurons_[i].getNumberOfSpike();
+		}
+		
+		vector<char>& text = parts[w];
+		text.resize(spikes*spikeLineSize);
+		char* p = text.data();
+		
+		for (size_t i(begin); i<end; ++i)
+		{
+			const vector<double, ArenaAllocator<double> >& times = neurons_[i].getSpikeHistory();
+			for (size_t j(0); j<times.size(); ++j)
+			{
+				p = formatSpikeLine(times[j], i, p);
+			}
+		}
+		text.resize(p-text.data());
+	};
+	
+	vector<thread> threads;
+	for (size_t w(1); w<workers; ++w)
+	{
+		threads.push_back(thread(format, w));
+	}
+	format(0);
+	for (size_t w(0); w<threads.size(); ++w)
+	{
+		threads[w].join();
+	}
+	
+	for (size_t w(0); w<workers; ++w)
+	{
+		data.write(parts[w].data(), parts[w].size());
+	}
+}	
+
+template <class Model>
+void NetworkT<Model>::saveSpikeStore(const string& file, unsigned int block) const
+{
+	SpikeStore::write(file, getSpikeTrains(), netClock_, block);
+}
+
+	//////////////////////////////
+	//                          //
+	//		  Simulation		//
+	//                          //
+	//////////////////////////////
+
+template <class Model>
+void NetworkT<Model>::runSimulation(unsigned int t_stop)
+{		
+	/*
+	 * the samples of the probes are allocated before the simulation; a
+	 * short run (step(1) for instance) reserves at least twice the
+	 * capacity, so that many short runs do not copy the samples each time
+	 */
+	for (size_t k(0); k<probes_.size() and netClock_<t_stop; ++k)
+	{
+		Probe& p = probes_[k];
+		size_t samples = p.V.size() + (t_stop-netClock_)/p.interval + 1;
+		if(samples > p.V.capacity())
+		{
+			samples = max(samples, 2*p.V.capacity());
+			p.V.reserve(samples);
+			p.input.reserve(samples);
+		}
+	}
+	
+	statusStop_.store(t_stop, memory_order_relaxed);
+	
+	if(delivery_ == PULL and blocks_.size() > 1 and netClock_ < t_stop)
+	{
+		if(workers_ == nullptr)
+		{
+			startWorkers();
+		}
+		
+		unsigned int start = netClock_;
+		receiveInput(start);
+		
+		//the parked workers read the steps once they pass the barrier
+		workers_->start = start;
+		workers_->stop = t_stop;
+		workers_->barrier.wait();
+		
+		runBlock(0, start, t_stop);
+		
+		netClock_ = t_stop;
+	}
+	
+	while(netClock_ < t_stop)
+	{
+		
+		update();
+	
+		++netClock_;
+		
+		statusClock_.store(netClock_, memory_order_relaxed);
+	}
+}
+
+template <class Model>
+void NetworkT<Model>::step(unsigned int n)
+{
+	runSimulation(netClock_+n);
+}
+
+template <class Model>
+void NetworkT<Model>::runBlock(size_t b, unsigned int start, unsigned int t_stop)
+{
+	/*
+	 * each worker updates its block, waits for the others to know all
+	 * the spikes of the step and then delivers the ones landing in its
+	 * block
+	 */
+	for (unsigned int t(start); t<t_stop; ++t)
+	{
+		updateBlock(b, t);
+		workers_->barrier.wait();
+		
+		//the lists of spikes are not changed before the next barrier
+		if(b == 0)
+		{
+			size_t spikes(0);
+			for (size_t k(0); k<blocks_.size(); ++k)
+			{
+				spikes += blocks_[k].spikes.size();
+			}
+			statusSpikes_.fetch_add(spikes, memory_order_relaxed);
+			
+			//the noise of every block is drawn, and the input only
+			//changes Iext_, not read by the delivery
+			endStep(t);
+			if(t+1 < t_stop)
+			{
+				receiveInput(t+1);
+			}
+		}
+		
+		deliverBlock(b, t);
+		workers_->barrier.wait();
+		
+		if(b == 0)
+		{
+			statusClock_.store(t+1, memory_order_relaxed);
+		}
+	}
+}
+
+template <class Model>
+void NetworkT<Model>::startWorkers()
+{
+	workers_.reset(new Workers(blocks_.size()));
+	
+	for (size_t b(1); b<blocks_.size(); ++b)
+	{
+		workers_->threads.push_back(thread([this, b]()
+		{
+			while(true)
+			{
+				workers_->barrier.wait();
+				if(workers_->quit)
+				{
+					return;
+				}
+				runBlock(b, workers_->start, workers_->stop);
+			}
+		}));
+	}
+}
+
+template <class Model>
+void NetworkT<Model>::stopWorkers()
+{
+	if(workers_ == nullptr)
+	{
+		return;
+	}
+	
+	workers_->quit = true;
+	workers_->barrier.wait();
+	
+	for (size_t i(0); i<workers_->threads.size(); ++i)
+	{
+		workers_->threads[i].join();
+	}
+	workers_.reset();
+}
+
+template <class Model>
+void NetworkT<Model>::setSpikeStream(SpikeStream* stream)
+{
+	spikeStream_ = stream;
+}
+
+template <class Model>
+void NetworkT<Model>::setInputStream(InputStream* stream, bool lockstep)
+{
+	inputStream_ = stream;
+	lockstep_ = lockstep;
+	
+	if(stream != nullptr and Iinput_.empty())
+	{
+		Iinput_.assign(N, 0.0);
+	}
+}
+
+template <class Model>
+bool NetworkT<Model>::recordNoise(const string& file)
+{
+	stopNoise();
+	
+	recorder_.reset(new NoiseRecorder(file, N, netClock_, V_ext*Ce));
+	if(!recorder_->isOpen())
+	{
+		recorder_.reset();
+		return false;
+	}
+	return true;
+}
+
+template <class Model>
+bool NetworkT<Model>::replayNoise(const string& file)
+{
+	stopNoise();
+	
+	tape_.reset(new NoiseTape(file));
+	if(!tape_->isOpen() or tape_->getNumberOfNeurons() != N)
+	{
+		if(tape_->isOpen())
+		{
+			cerr << "ERROR: " << file << " records " << tape_->getNumberOfNeurons()
+				 << " neurons instead of " << N << endl;
+		}
+		tape_.reset();
+		return false;
+	}
+	return true;
+}
+
+template <class Model>
+void NetworkT<Model>::stopNoise()
+{
+	recorder_.reset();
+	tape_.reset();
+}
+
+template <class Model>
+void NetworkT<Model>::update()
+{
+	receiveInput(netClock_);
+	
+	if(delivery_ == BATCHED)
+	{
+		/*
+		 * every neuron is updated and the ones that spike are listed in
+		 * the first tile, then each tile recieves all of its input
+		 */
+		blocks_[0].spikes.clear();
+		updateRange(0, N, netClock_, gen_, poisson_, &blocks_[0].spikes);
+		statusSpikes_.fetch_add(blocks_[0].spikes.size(), memory_order_relaxed);
+		
+		for (size_t b(0); b<blocks_.size(); ++b)
+		{
+			deliverBlock(b, netClock_);
+		}
+		endStep(netClock_);
+		return;
+	}
+	
+	if(delivery_ == PULL)
+	{
+		size_t spikes(0);
+		for (size_t b(0); b<blocks_.size(); ++b)
+		{
+			updateBlock(b, netClock_);
+			spikes += blocks_[b].spikes.size();
+		}
+		statusSpikes_.fetch_add(spikes, memory_order_relaxed);
+		
+		for (size_t b(0); b<blocks_.size(); ++b)
+		{
+			deliverBlock(b, netClock_);
+		}
+		endStep(netClock_);
+		return;
+	}
+	
+	stepSpikes_ = 0;
+	updateRange(0, N, netClock_, gen_, poisson_, nullptr);
+	statusSpikes_.fetch_add(stepSpikes_, memory_order_relaxed);
+	endStep(netClock_);
+}
+
+template <class Model>
+void NetworkT<Model>::receiveInput(unsigned int t)
+{
+	if(inputStream_ == nullptr)
+	{
+		return;
+	}
+	
+	while(true)
+	{
+		const InputCommand* commands;
+		size_t n = inputStream_->read(commands);
+		size_t k(0);
+		
+		for (; k<n; ++k)
+		{
+			const InputCommand& c = commands[k];
+			
+			if(c.neuron == endOfStep)
+			{
+				inputReady_ = max(inputReady_, c.time+1);
+				continue;
+			}
+			
+			//the commands of the next steps stay in the stream
+			if(c.time > t)
+			{
+				break;
+			}
+			
+			if(c.neuron >= N)
+			{
+				cerr << "ERROR: input command for the neuron " << c.neuron << endl;
+				continue;
+			}
+			
+			/*
+			 * the neurons without stimulus keep their current from one
+			 * step to the next, the others start again from Iinput_
+			 */
+			Iext_[c.neuron] += c.current - Iinput_[c.neuron];
+			Iinput_[c.neuron] = c.current;
+		}
+		
+		inputStream_->release(k);
+		
+		//a command of a later step also ends the input of this one
+		if(k < n or (n == 0 and (!lockstep_ or inputReady_ > t)))
+		{
+			return;
+		}
+		if(n == 0)
+		{
+			this_thread::yield();
+		}
+	}
+}
+
+template <class Model>
+void NetworkT<Model>::endStep(unsigned int t)
+{
+	if(recorder_ != nullptr)
+	{
+		recorder_->endStep();
+	}
+	
+	if(spikeStream_ == nullptr)
+	{
+		return;
+	}
+	
+	//in push mode the spikes are written as they are delivered
+	if(delivery_ != PUSH)
+	{
+		for (size_t b(0); b<blocks_.size(); ++b)
+		{
+			const vector<int>& spikes = blocks_[b].spikes;
+			for (size_t s(0); s<spikes.size(); ++s)
+			{
+				spikeStream_->write(SpikeEvent{t, uint32_t(spikes[s])});
+			}
+		}
+	}
+	
+	spikeStream_->write(SpikeEvent{t, endOfStep});
+	spikeStream_->publish();
+}
+
+template <class Model>
+void NetworkT<Model>::updateRange(size_t begin, size_t end, unsigned int t, mt19937& gen,
+								  poisson_distribution<int>& poisson, vector<int>* spikes)
+{
+	applyStimuli(begin, end, t);
+	
+	size_t i(begin);
+	
+	//input recieved by the last neuron sampled by a probe
+	double input(0.0);
+	
+	/*
+	 * the neurons sampled by a probe during this step are updated apart,
+	 * the others all go through the plain loop below
+	 */
+	vector<size_t>::const_iterator k = lower_bound(probeOrder_.begin(), probeOrder_.end(), begin,
+		[this](size_t id, size_t n){ return probes_[id].neuron < n; });
+	
+	for (; k != probeOrder_.end() and probes_[*k].neuron < end; ++k)
+	{
+		Probe& p = probes_[*k];
+		
+		if((t-p.start) % p.interval != 0)
+		{
+			continue;
+		}
+		
+		//the neuron can already be updated if it has several probes
+		if(p.neuron >= i)
+		{
+			for (; i<p.neuron; ++i)
+			{
+				stepNeuron(i, Iext_[i], externalSpikes(i, t, gen, poisson)*Je, spikes);
+			}
+			
+			double Jext = externalSpikes(i, t, gen, poisson)*Je;
+			input = neurons_[i].getInput() + Jext;
+			stepNeuron(i, Iext_[i], Jext, spikes);
+			++i;
+		}
+		
+		p.input.push_back(input);
+		p.V.push_back(neurons_[p.neuron].getMembranePotential());
+	}
+	
+	for (; i<end; ++i)
+	{
+		//external random noise recieved by the neuron during this step
+		double Jext = externalSpikes(i, t, gen, poisson)*Je;
+		
+		stepNeuron(i, Iext_[i], Jext, spikes);
+	}
+}
+
+template <class Model>
+int NetworkT<Model>::externalSpikes(size_t i, unsigned int t, mt19937& gen,
+									poisson_distribution<int>& poisson)
+{
+	if(!neurons_[i].integrates())
+	{
+		return 0;
+	}
+	
+	if(tape_ != nullptr and tape_->hasStep(t))
+	{
+		return tape_->get(t, i);
+	}
+	
+	int k = noise_ ? poisson(gen) : 0;
+	if(recorder_ != nullptr)
+	{
+		recorder_->set(i, k);
+	}
+	return k;
+}
+
+template <class Model>
+void NetworkT<Model>::applyStimuli(size_t begin, size_t end, unsigned int t)
+{
+	/*
+	 * the current of the neurons of every group is set back to 0, then
+	 * each active stimulus is evaluated once and added to its group
+	 */
+	for (int pass(0); pass<2; ++pass)
+	{
+		for (size_t k(0); k<injections_.size(); ++k)
+		{
+			const Injection& inj = injections_[k];
+			
+			if(pass == 1 and !inj.stimulus.isActive(t))
+			{
+				continue;
+			}
+			
+			double I = (pass == 0) ? 0.0 : inj.stimulus.getCurrent(t);
+			
+			vector<int>::const_iterator n = lower_bound(inj.neurons.begin(), inj.neurons.end(), int(begin));
+			for (; n != inj.neurons.end() and size_t(*n) < end; ++n)
+			{
+				if(pass == 0)
+				{
+					Iext_[*n] = Iinput_.empty() ? 0.0 : Iinput_[*n];
+				}
+				else
+				{
+					Iext_[*n] += I;
+				}
+			}
+		}
+	}
+}
+
+template <class Model>
+void NetworkT<Model>::stepNeuron(size_t i, double Iext, double Jext, vector<int>* spikes)
+{
+	//check for each neuron if it spiked during this update
+	if(neurons_[i].step(Iext, Jext))
+	{
+		//in pull mode the spike is only listed, it is delivered later
+		if(spikes != nullptr)
+		{
+			spikes->push_back(i);
+			return;
+		}
+		
+		++stepSpikes_;
+		
+		if(spikeStream_ != nullptr)
+		{
+			spikeStream_->write(SpikeEvent{netClock_, uint32_t(i)});
+		}
+		
+		/*
+		 * if yes we transmit the corresponding electrical imput
+		 * (Je = 0.1 if the neuron is excitatory, Ji =-0.5 if it is
+		 * inhibitory) to all its post synaptic neurons
+		 */
+		if(neurons_[i].isExcitatory())
+		{
+			if(plastic_)
+			{
+				potentiate(i, netClock_);
+			}
+			
+			for(int j(offsets_[i]); j<ends_[i]; ++j)
+			{
+				int post = targets_[j]; 
+				double J = Je;
+				
+				/*
+				 * a plastic synapse is depressed by the post-synaptic
+				 * trace of its target before being delivered
+				 */
+				if(plastic_ and post < Ne)
+				{
+					const Trace& trace = traces_[post];
+					size_t dt = netClock_-trace.last;
+					if(dt < decayPost_.size())
+					{
+						weights_[j] = max(0.0, weights_[j] - Aminus_*trace.post*decayPost_[dt]);
+					}
+					J = weights_[j];
+				}
+				
+				/*
+				 * the electrical imput is written in the buffer of
+				 * the post synaptic neuron with a delay D=15ms
+				 */
+				neurons_[post].setBufferAt(netClock_+D, J);
+			}
+		}
+		else
+		{
+			for(int j(offsets_[i]); j<ends_[i]; ++j)
+			{
+				neurons_[targets_[j]].setBufferAt(netClock_+D, Ji);
+			}
+		}
+	}
+}
+
+template <class Model>
+void NetworkT<Model>::potentiate(size_t post, unsigned int t)
+{
+	if(!incomingValid_)
+	{
+		buildIncoming();
+	}
+	
+	/*
+	 * the incoming synapses are sorted by pre-synaptic neuron, so the
+	 * excitatory ones come first
+	 */
+	for (int s(inOffsets_[post]); s<inOffsets_[post+1] and sources_[s] < Ne; ++s)
+	{
+		const Trace& trace = traces_[sources_[s]];
+		size_t dt = t-trace.last;
+		if(dt < decayPre_.size())
+		{
+			float& w = weights_[inSynapses_[s]];
+			w = min(Jmax_, float(w + Aplus_*trace.pre*decayPre_[dt]));
+		}
+	}
+	
+	//the spike is added to the traces of the neuron
+	Trace& trace = traces_[post];
+	size_t dt = t-trace.last;
+	trace.pre = ((dt < decayPre_.size()) ? trace.pre*decayPre_[dt] : 0.0) + 1;
+	trace.post = ((dt < decayPost_.size()) ? trace.post*decayPost_[dt] : 0.0) + 1;
+	trace.last = t;
+}
+
+template <class Model>
+void NetworkT<Model>::setDeliveryMode(delivery_mode mode, unsigned int workers)
+{
+	if(plastic_ and mode != PUSH)
+	{
+		cerr << "ERROR: plasticity needs the push delivery" << endl;
+		return;
+	}
+	
+	//the threads of the old blocks end
+	stopWorkers();
+	delivery_ = mode;
+	
+	if(mode == PULL)
+	{
+		partition(workers > 0 ? workers : 1);
+	}
+	else if(mode == BATCHED)
+	{
+		/*
+		 * the neurons of a tile fill half of the L2 cache, the other half
+		 * is left to the spike list and the rows being read
+		 */
+		long cache = sysconf(_SC_LEVEL2_CACHE_SIZE);
+		size_t bytes = (cache > 0) ? cache/2 : tileBytes;
+		size_t tile = max(bytes/sizeof(NeuronT<Model>), size_t(1));
+		partition((N+tile-1)/tile);
+	}
+	else
+	{
+		blocks_.clear();
+	}
+}
+
+template <class Model>
+void NetworkT<Model>::partition(unsigned int workers)
+{
+	if(workers > N)
+	{
+		workers = N;
+	}
+	
+	blocks_.clear();
+	blocks_.reserve(workers);
+	
+	size_t size = (N+workers-1)/workers;
+	
+	/*
+	 * the seeds of the blocks are drawn from a copy of the generator of
+	 * the network, so that the noise of the first block is not changed;
+	 * they are only drawn here, a rewiring keeps the generators of the
+	 * blocks (see connectBlocks) and thus their noise
+	 */
+	mt19937 seeder(gen_);
+	
+	for (size_t b(0); b<workers; ++b)
+	{
+		blocks_.push_back(Block(&arena_, seeder()));
+		
+		Block& block = blocks_.back();
+		block.begin = min(b*size, size_t(N));
+		block.end = min((b+1)*size, size_t(N));
+		block.spikes.reserve(block.end-block.begin);
+	}
+	
+	connectBlocks();
+}
+
+template <class Model>
+void NetworkT<Model>::connectBlocks()
+{
+	size_t workers = blocks_.size();
+	size_t size = (N+workers-1)/workers;
+	
+	//the arrays of the blocks are reused when the map is rewired
+	for (size_t b(0); b<workers; ++b)
+	{
+		blocks_[b].offsets.assign(N+1, 0);
+	}
+	
+	/*
+	 * the connections are split between the blocks of their post-synaptic
+	 * neurons: a first pass counts them, a second one writes them
+	 */
+	for (size_t i(0); i<N; ++i)
+	{
+		for (int j(offsets_[i]); j<ends_[i]; ++j)
+		{
+			++blocks_[targets_[j]/size].offsets[i+1];
+		}
+	}
+	
+	vector< vector<int> > fill(workers);
+	for (size_t b(0); b<workers; ++b)
+	{
+		Block& block = blocks_[b];
+		for (size_t i(0); i<N; ++i)
+		{
+			block.offsets[i+1] += block.offsets[i];
+		}
+		
+		size_t count = block.offsets[N];
+		if(count > block.targets.capacity())
+		{
+			block.targets.reserve(max(count, block.targets.capacity() + block.targets.capacity()/2));
+		}
+		block.targets.resize(count);
+		fill[b].assign(block.offsets.begin(), block.offsets.end()-1);
+	}
+	
+	for (size_t i(0); i<N; ++i)
+	{
+		for (int j(offsets_[i]); j<ends_[i]; ++j)
+		{
+			size_t b = targets_[j]/size;
+			blocks_[b].targets[fill[b][i]++] = targets_[j];
+		}
+	}
+}
+
+template <class Model>
+void NetworkT<Model>::buildIncoming(unsigned int workers)
+{
+	if(workers == 0)
+	{
+		workers = 1;
+	}
+	if(workers > N)
+	{
+		workers = N;
+	}
+	
+	size_t size = (N+workers-1)/workers;
+	
+	/*
+	 * first each worker counts the connections of its pre-synaptic
+	 * neurons landing on each neuron
+	 */
+	vector< vector<int> > counts(workers);
+	
+	auto count = [&](size_t w)
+	{
+		counts[w].assign(N, 0);
+		for (size_t i(w*size); i<min((w+1)*size, size_t(N)); ++i)
+		{
+			for (int j(offsets_[i]); j<ends_[i]; ++j)
+			{
+				++counts[w][targets_[j]];
+			}
+		}
+	};
+	
+	vector<thread> threads;
+	for (size_t w(1); w<workers; ++w)
+	{
+		threads.push_back(thread(count, w));
+	}
+	count(0);
+	for (size_t w(0); w<threads.size(); ++w)
+	{
+		threads[w].join();
+	}
+	
+	/*
+	 * then the rows are placed, and inside a row the part of each worker
+	 * comes after the ones of the previous workers: counts becomes the
+	 * place where each worker writes its next connection
+	 */
+	inOffsets_.assign(N+1, 0);
+	for (size_t i(0); i<N; ++i)
+	{
+		int place = inOffsets_[i];
+		for (size_t w(0); w<workers; ++w)
+		{
+			int c = counts[w][i];
+			counts[w][i] = place;
+			place += c;
+		}
+		inOffsets_[i+1] = place;
+	}
+	sources_.resize(inOffsets_[N]);
+	if(plastic_)
+	{
+		inSynapses_.resize(inOffsets_[N]);
+	}
+	
+	/*
+	 * finally each worker writes its connections, the pre-synaptic
+	 * neurons of a row are thus sorted
+	 */
+	auto fill = [&](size_t w)
+	{
+		for (size_t i(w*size); i<min((w+1)*size, size_t(N)); ++i)
+		{
+			for (int j(offsets_[i]); j<ends_[i]; ++j)
+			{
+				int place = counts[w][targets_[j]]++;
+				sources_[place] = i;
+				if(plastic_)
+				{
+					inSynapses_[place] = j;
+				}
+			}
+		}
+	};
+	
+	threads.clear();
+	for (size_t w(1); w<workers; ++w)
+	{
+		threads.push_back(thread(fill, w));
+	}
+	fill(0);
+	for (size_t w(0); w<threads.size(); ++w)
+	{
+		threads[w].join();
+	}
+	
+	incomingValid_ = true;
+}
+
+template <class Model>
+void NetworkT<Model>::updateBlock(size_t b, unsigned int t)
+{
+	Block& block = blocks_[b];
+	block.spikes.clear();
+	
+	/*
+	 * the first block draws its noise from the generator of the network
+	 * so that with a single worker only the delivery differs from the
+	 * push simulation
+	 */
+	mt19937& gen = (b == 0) ? gen_ : block.gen;
+	poisson_distribution<int>& poisson = (b == 0) ? poisson_ : block.poisson;
+	
+	updateRange(block.begin, block.end, t, gen, poisson, &block.spikes);
+}
+
+template <class Model>
+void NetworkT<Model>::deliverBlock(size_t b, unsigned int t)
+{
+	Block& block = blocks_[b];
+	
+	/*
+	 * the spikes are read block after block, that is by increasing
+	 * pre-synaptic neuron as in push mode
+	 */
+	for (size_t k(0); k<blocks_.size(); ++k)
+	{
+		const vector<int>& spikes = blocks_[k].spikes;
+		
+		for (size_t s(0); s<spikes.size(); ++s)
+		{
+			int pre = spikes[s];
+			double J = neurons_[pre].isExcitatory() ? Je : Ji;
+			
+			for (int j(block.offsets[pre]); j<block.offsets[pre+1]; ++j)
+			{
+				neurons_[block.targets[j]].setBufferAt(t+D, J);
+			}
+		}
+	}
+}
+
+	//////////////////////////////
+	//                          //
+	//	   Instantiations		//
+	//                          //
+	//////////////////////////////
 
-
-
+template class NetworkT<LIF>;
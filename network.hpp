@@ -2,12 +2,51 @@
 #define network_HPP
 
 #include "neuron.hpp"
+#include "arena.hpp"
+#include "stimulus.hpp"
+#include "eventstream.hpp"
+#include "noisetape.hpp"
 
 #include <iostream>
 #include <vector>
+#include <string>
+#include <random>
+#include <thread>
+#include <atomic>
+#include <memory>
 
 using namespace std;
 
+/*
+ * tells how the spikes are delivered:
+ * PUSH: a neuron that spikes writes directly in the buffers of its targets
+ * PULL: the neurons are split in blocks, one per worker, and each worker
+ * 		 reads the list of the neurons that spiked and applies only the
+ * 		 connections landing in its own block (no lock needed)
+ * BATCHED: the neurons that spiked are listed during the step and their
+ * 		 spikes are delivered afterwards, tile after tile of targets small
+ * 		 enough to stay in cache (one thread)
+ */
+enum delivery_mode{PUSH, PULL, BATCHED};
+
+/*!
+ * @brief connection from the neuron pre to the neuron post (see the
+ * 		  rewiring methods of the network)
+ */
+struct Synapse
+{
+	unsigned int pre, post;
+};
+
+/*!
+ * @brief move of a connection of the neuron pre from the neuron from to
+ * 		  the neuron to
+ */
+struct Rewiring
+{
+	unsigned int pre, from, to;
+};
+
 /*!
  * @brief network class
  * 
@@ -15,25 +54,223 @@ using namespace std;
  * neurons. It is in charge of creating the connection between the neurons
  * in a random fashion and to deliver the information from one to another
  * following those connections.
+ * 
+ * it is templated on the same model policy as its neurons (see model.hpp)
  */
-class Network
+template <class Model = LIF>
+class NetworkT
 {
 	private:
 		
+		//!arena owning all the memory of the simulation
+		//!(declared first so that it is destroyed last)
+		Arena arena_;
+		
 		//!list of all the neurons in the network
-		vector <Neuron> neurons_;
+		vector < NeuronT<Model>, ArenaAllocator< NeuronT<Model> > > neurons_;
+		
+		//!map of the connections for each neurons, stored row by row:
+		//!the post-synaptic neurons of the neuron i are
+		//!targets_[offsets_[i]] ... targets_[ends_[i]-1], the places up
+		//!to offsets_[i+1] are left free for the rewiring
+		vector<int, ArenaAllocator<int> > offsets_;
+		vector<int, ArenaAllocator<int> > targets_;
+		vector<int, ArenaAllocator<int> > ends_;
+		
+		//!free places given to each row when the map is laid out again
+		size_t slack_;
+		
+		//!transposed map, built on demand: the pre-synaptic neurons of the
+		//!neuron i are sources_[inOffsets_[i]] ... sources_[inOffsets_[i+1]-1]
+		vector<int, ArenaAllocator<int> > inOffsets_;
+		vector<int, ArenaAllocator<int> > sources_;
 		
-		//!matrix that map the connections for each neurons
-		//!lines : neuron
-		//!column : post-synaptic neurons 
-		vector< vector<int> > connectionMap_;
+		//!tells if the transposed map is up to date with the connections
+		bool incomingValid_;
+		
+		//!position in targets_ of each connection of the transposed map
+		//!(only built when the synapses are plastic)
+		vector<int, ArenaAllocator<int> > inSynapses_;
+		
+		//!tells if the E->E synapses are plastic (see enablePlasticity)
+		bool plastic_;
+		
+		//!weight of the connections of the excitatory neurons, stored like
+		//!targets_ (only the rows 0 to Ne-1); only the E->E ones change
+		vector<float, ArenaAllocator<float> > weights_;
+		
+		/*!
+		 * @brief exponential traces of the spikes of an excitatory neuron
+		 * 
+		 * they are only updated when the neuron spikes, their value at a
+		 * later step is obtained with the decay tables below
+		 */
+		struct Trace
+		{
+			//!step of the last spike
+			unsigned int last;
+			
+			//!pre- and post-synaptic traces just after the last spike
+			double pre, post;
+		};
+		
+		//!traces of the excitatory neurons
+		vector<Trace, ArenaAllocator<Trace> > traces_;
+		
+		//!decay of the pre- and post-synaptic traces after k steps
+		//!(a trace older than the table is considered null)
+		vector<double> decayPre_, decayPost_;
+		
+		//!potentiation and depression of the plastic synapses
+		double Aplus_, Aminus_;
+		
+		//!maximal weight of the plastic synapses, stored like the weights
+		//!so that a clamped weight is exactly the bound
+		float Jmax_;
+		
+		/*!
+		 * @brief block of post-synaptic neurons delivered by one worker
+		 * 		  in pull mode
+		 */
+		struct Block
+		{
+			//!first and last+1 neurons of the block
+			size_t begin, end;
+			
+			//!connections landing in the block, stored row by row like
+			//!offsets_ and targets_ (one row for every neuron of the network)
+			vector<int, ArenaAllocator<int> > offsets;
+			vector<int, ArenaAllocator<int> > targets;
+			
+			//!neurons of the block that spiked during the last step
+			vector<int> spikes;
+			
+			//!generator of the external noise of the block
+			//!(the first block uses the one of the network)
+			mt19937 gen;
+			poisson_distribution<int> poisson;
+			
+			Block(Arena* arena, unsigned int seed);
+		};
 		
 		//!local clock of the network
 		unsigned int netClock_;
 		
+		//!random generator used for the connections and the external noise
+		mt19937 gen_;
+		
+		//!distribution of the number of external spikes recieved in a step
+		poisson_distribution<int> poisson_;
+		
+		//!tells if the neurons recieve the external noise
+		bool noise_;
+		
+		//!how the spikes are delivered
+		delivery_mode delivery_;
+		
+		//!blocks of neurons of the pull mode, one per worker, or tiles of
+		//!the batched mode
+		vector<Block> blocks_;
+		
+		//!threads of the blocks after the first one in pull mode: they are
+		//!started by the first run and wait on a barrier between two runs
+		//!(null when there are none, see runSimulation)
+		struct Workers;
+		unique_ptr<Workers> workers_;
+		
+		/*!
+		 * @brief probe recording the membrane potential and the input of
+		 * 		  a neuron every interval steps
+		 */
+		struct Probe
+		{
+			//!neuron sampled
+			size_t neuron;
+			
+			//!number of steps between two samples
+			unsigned int interval;
+			
+			//!step of the first sample
+			unsigned int start;
+			
+			//!membrane potential after the update of each sample
+			vector<double, ArenaAllocator<double> > V;
+			
+			//!input recieved (buffer and external noise) at each sample
+			vector<double, ArenaAllocator<double> > input;
+			
+			Probe(Arena* arena, size_t n, unsigned int dt, unsigned int t0);
+		};
+		
+		//!probes attached to the network
+		vector<Probe> probes_;
+		
+		//!indices of the probes sorted by neuron
+		vector<size_t> probeOrder_;
+		
+		/*!
+		 * @brief external current injected in a group of neurons
+		 */
+		struct Injection
+		{
+			Stimulus stimulus;
+			
+			//!neurons recieving the current (sorted)
+			vector<int> neurons;
+		};
+		
+		//!external currents injected in the network
+		vector<Injection> injections_;
+		
+		//!external current recieved by each neuron during the current step
+		vector<double, ArenaAllocator<double> > Iext_;
+		
+		//!progress of runSimulation, published once per step so that an
+		//!other thread can read it (see getStatus)
+		atomic<unsigned int> statusClock_, statusStop_;
+		atomic<size_t> statusSpikes_;
+		
+		//!number of spikes of the current step in push mode
+		size_t stepSpikes_;
+		
+		//!streams linking the network to a controller (see step), null
+		//!when not used
+		SpikeStream* spikeStream_;
+		InputStream* inputStream_;
+		
+		//!tells if a step waits for the end of its input
+		bool lockstep_;
+		
+		//!first step whose input is not known to be complete
+		unsigned int inputReady_;
+		
+		//!current set by the input commands of each neuron (allocated
+		//!with the input stream), the stimuli are added to it
+		vector<double, ArenaAllocator<double> > Iinput_;
+		
+		//!record of the noise drawn and tape of the noise replayed (see
+		//!recordNoise and replayNoise), null when not used
+		unique_ptr<NoiseRecorder> recorder_;
+		unique_ptr<NoiseTape> tape_;
+		
 		
 	public:
 	
+		/*!
+		 * @brief progress of a simulation (see getStatus)
+		 */
+		struct Status
+		{
+			//!last step done and last step of the current run
+			unsigned int clock, stop;
+			
+			//!number of spikes since the network was built
+			size_t spikes;
+			
+			//!memory allocated for the simulation in bytes
+			size_t footprint;
+		};
+	
 	//////////////////////////////
 	//                          //
 	// constructor & destructor //
@@ -44,13 +281,24 @@ class Network
 		 * @brief initialise a network with a number N of neuron given by the
 		 * 		  constant file, a matrix mapping all the connection between
 		 * 		  these neurons and an internal clock at t=0
+		 * 		  the random generator is seeded by a random device
 		 */	
-		Network();
+		NetworkT();
+		
+		/*!
+		 * @brief same as the default constructor but with a given seed
+		 * 		  two networks built with the same seed have the same
+		 * 		  connections and recieve the same external noise
+		 * 
+		 * @param unsigned int seed seed of the random generator
+		 * @param page_mode pages how the memory of the network is backed
+		 */	
+		NetworkT(unsigned int seed, page_mode pages = STANDARD);
 		
 		/*!
 		 * @brief destructor
 		 */	
-		~Network();
+		~NetworkT();
 		
 	//////////////////////////////
 	//                          //
@@ -61,17 +309,83 @@ class Network
 		/*!
 		 * @brief get the list of the neurons in the network
 		 * 
-		 * @return vector<Neuron> neurons_
+		 * @return vector< NeuronT<Model> > neurons_
 		 */
-		vector<Neuron> getNeurons();
+		vector< NeuronT<Model> > getNeurons();
 		
 		/*!
 		 * @brief get the connection map of the network
 		 * 
-		 * @return vector< vector<int> > connectionMap_
+		 * @return vector< vector<int> > the post-synaptic neurons of each neuron
 		 */
 		vector< vector<int> > getConnectionMap();
 		
+		/*!
+		 * @brief get the pre-synaptic neurons of a neuron (sorted, a neuron
+		 * 		  appears once for each of its connections)
+		 * 
+		 * the first call builds the transposed connection map, after
+		 * that a query only costs the in-degree of the neuron
+		 * 
+		 * @param unsigned int post index of the post-synaptic neuron
+		 * 
+		 * @return vector<int> indices of its pre-synaptic neurons
+		 */
+		vector<int> getPresynaptic(unsigned int post);
+		
+		/*!
+		 * @brief get the number of connections recieved by a neuron
+		 * 
+		 * @param unsigned int post index of the post-synaptic neuron
+		 */
+		int getInDegree(unsigned int post);
+		
+		/*!
+		 * @brief get the total number of connections of the network
+		 */
+		size_t getNumberOfConnections() const;
+		
+		/*!
+		 * @brief get the weights of the connections of a neuron, in the
+		 * 		  order of its row of the connection map
+		 * 
+		 * @param unsigned int pre index of the pre-synaptic neuron
+		 */
+		vector<double> getWeights(unsigned int pre) const;
+		
+		/*!
+		 * @brief get the spike times of every neuron of the network
+		 * 
+		 * @return vector< vector<double> > spike times of each neuron
+		 */
+		vector< vector<double> > getSpikeTrains() const;
+		
+		/*!
+		 * @brief get the current step of the network
+		 */
+		unsigned int getClock() const;
+		
+		/*!
+		 * @brief get the total number of spikes of the network so far
+		 */
+		size_t getNumberOfSpike() const;
+		
+		/*!
+		 * @brief get the progress of the simulation
+		 * 
+		 * unlike the other getters it can be called by an other thread
+		 * while runSimulation is running (see progress.hpp)
+		 */
+		Status getStatus() const;
+		
+		/*!
+		 * @brief get the memory allocated for the simulation (neurons,
+		 * 		  connections and spike histories) in bytes
+		 * 
+		 * @return size_t footprint of the arena of the network
+		 */
+		size_t getFootprint() const;
+		
 	//////////////////////////////
 	//                          //
 	//			Display			//
@@ -117,7 +431,138 @@ class Network
 	 * used for test purpose in a previous version
 	 */
 	void setManualConnection (unsigned int pre, unsigned int post);
+	
+	/*!
+	 * @brief tells if the neurons recieve the external noise (true by
+	 * 		  default); without it a network only moves with its stimuli
+	 * 		  and its input commands
+	 */
+	void setExternalNoise(bool enabled);
+	
+	//////////////////////////////
+	//                          //
+	//		   Rewiring			//
+	//                          //
+	//////////////////////////////
+	/*
+	 * each row of the connection map keeps some free places, so that a
+	 * connection is added or removed without moving the other rows; the
+	 * map is only laid out again (in O(connections)) when a row is full or
+	 * when too many places were freed. The delivery reads the rows as
+	 * before, only the free places in between are skipped
+	 */
+	
+	/*!
+	 * @brief add connections at the end of the rows of their pre-synaptic
+	 * 		  neurons
+	 * 
+	 * @return size_t number of connections added (none if one of them
+	 * 		   is out of range)
+	 */
+	size_t addConnections(const vector<Synapse>& synapses);
+	
+	/*!
+	 * @brief remove one connection pre->post for each synapse given (the
+	 * 		  last connection of the row takes its place)
+	 * 
+	 * @return size_t number of connections found and removed
+	 */
+	size_t removeConnections(const vector<Synapse>& synapses);
+	
+	/*!
+	 * @brief give an other post-synaptic neuron to connections, in place
+	 * 		  (a plastic connection starts again with the weight Je)
+	 * 
+	 * @return size_t number of connections found and moved
+	 */
+	size_t rewireConnections(const vector<Rewiring>& rewirings);
+	
+	/*!
+	 * @brief set the number of free places given to each row when the
+	 * 		  map is laid out again
+	 */
+	void setRowSlack(size_t slack);
+	
+	/*!
+	 * @brief lay the map out again without any free place, as it was
+	 * 		  built
+	 */
+	void compactConnections();
+	
+	/*!
+	 * @brief make the E->E synapses plastic (additive STDP)
+	 * 
+	 * each excitatory neuron keeps a pre- and a post-synaptic trace
+	 * increased by 1 at each of its spikes and decaying with tau_plus and
+	 * tau_minus. When a neuron spikes the weights of its incoming E->E
+	 * synapses are increased by Aplus times the pre-synaptic traces, and
+	 * the ones of its outgoing synapses are decreased by Aminus times the
+	 * post-synaptic traces while they are delivered; the weights stay in
+	 * [0, Jmax]. No spike history is read, so a plastic step only costs
+	 * the in-degree of the neurons that spike on top of the delivery.
+	 * 
+	 * only the push delivery supports plasticity
+	 */
+	void enablePlasticity(double Aplus = A_plus, double Aminus = A_minus, double Jmax = J_max);
 			
+	//////////////////////////////
+	//                          //
+	//		   Stimuli			//
+	//                          //
+	//////////////////////////////
+	
+		/*!
+		 * @brief inject an external current in a group of neurons
+		 * 
+		 * the current is evaluated once per step and written with the
+		 * others in a vector read by the update of the neurons
+		 * 
+		 * @param Stimulus stimulus the current (see stimulus.hpp)
+		 * @param vector<int> neurons the indices of the neurons
+		 */
+		void addStimulus(const Stimulus& stimulus, const vector<int>& neurons);
+		
+		/*!
+		 * @brief inject an external current in the neurons first to last-1
+		 */
+		void addStimulus(const Stimulus& stimulus, unsigned int first, unsigned int last);
+		
+	//////////////////////////////
+	//                          //
+	//			Probes			//
+	//                          //
+	//////////////////////////////
+	
+		/*!
+		 * @brief attach a probe sampling the membrane potential and the
+		 * 		  input of a neuron during the simulation
+		 * 
+		 * the samples are taken inside the update every interval steps
+		 * from now on, and allocated at the beginning of runSimulation;
+		 * the neurons without probe are not slowed down
+		 * 
+		 * @param unsigned int neuron index of the neuron sampled
+		 * @param unsigned int interval number of steps between two samples
+		 * 
+		 * @return size_t index of the probe (used by the getters below)
+		 */
+		size_t addProbe(unsigned int neuron, unsigned int interval = 1);
+		
+		/*!
+		 * @brief get the membrane potential sampled by a probe
+		 */
+		vector<double> getProbePotential(size_t probe) const;
+		
+		/*!
+		 * @brief get the input (buffer and external noise) sampled by a probe
+		 */
+		vector<double> getProbeInput(size_t probe) const;
+		
+		/*!
+		 * @brief get the steps at which a probe took its samples
+		 */
+		vector<double> getProbeTimes(size_t probe) const;
+		
 	//////////////////////////////
 	//                          //
 	//			Print			//
@@ -127,8 +572,26 @@ class Network
 		/*!
 		 * @brief print the spikes of each neuron in an external text file
 		 * 		  name neuron_data.txt located in the build folder
+		 * 
+		 * the neurons are split in ranges formatted in parallel (see
+		 * spiketext.hpp), the ranges are then written in order so the
+		 * file is the same as with an ostream
+		 * 
+		 * @param string file name of the file
+		 * @param unsigned int workers number of threads used
 		 */	
-		void printSpikeTimes();	
+		void printSpikeTimes(const string& file = "data_neuro.txt",
+							 unsigned int workers = thread::hardware_concurrency());	
+		
+		/*!
+		 * @brief write the spikes of each neuron in an indexed binary file
+		 * 		  that can be read by range of neurons and time (see
+		 * 		  spikestore.hpp)
+		 * 
+		 * @param string file name of the file
+		 * @param unsigned int block duration of a time block of the index
+		 */
+		void saveSpikeStore(const string& file, unsigned int block = 1000) const;
 			
 	//////////////////////////////
 	//                          //
@@ -143,6 +606,74 @@ class Network
 		 */	
 			void runSimulation(unsigned int t_stop);
 			
+		/*!
+		 * @brief run the next n steps of the simulation
+		 * 
+		 * the simulation can go on step after step, driven by a controller
+		 * linked to the network by the streams below: after each step its
+		 * spikes are published, followed by an end of step event, and
+		 * before each step the input commands due are applied
+		 * 
+		 * in pull mode the threads of the workers stay parked between two
+		 * calls, so a step only costs its two barriers
+		 * 
+		 * @param unsigned int n number of steps
+		 */
+			void step(unsigned int n = 1);
+			
+		/*!
+		 * @brief publish the spikes of each step in a stream
+		 * 
+		 * @param SpikeStream* stream the stream (null to stop), it has to
+		 * 		  outlive its use by the network
+		 */
+			void setSpikeStream(SpikeStream* stream);
+			
+		/*!
+		 * @brief read the input of the simulation in a stream
+		 * 
+		 * a command sets the current injected in a neuron from its step on
+		 * (the stimuli of the neuron are added to it); the commands have
+		 * to come by increasing step. In lockstep a step waits until the
+		 * controller sends the end of its input, otherwise the commands
+		 * arrived are applied and the step goes on
+		 * 
+		 * @param InputStream* stream the stream (null to stop)
+		 * @param bool lockstep if the steps wait for their input
+		 */
+			void setInputStream(InputStream* stream, bool lockstep = false);
+			
+		/*!
+		 * @brief record the external noise of the next steps in a file
+		 * 
+		 * the number of external spikes drawn for each neuron in each
+		 * step is written until stopNoise is called or the network is
+		 * destroyed (see noisetape.hpp), whatever the delivery mode.
+		 * The file takes N bytes per step: 125MB per simulated second
+		 * with N = 12500, stopNoise keeps it to the steps needed
+		 * 
+		 * @return bool false if the file could not be opened
+		 */
+			bool recordNoise(const string& file);
+			
+		/*!
+		 * @brief replay the external noise recorded in a file
+		 * 
+		 * during the steps recorded the neurons recieve the noise of the
+		 * file instead of drawing it: no random number is drawn, and a
+		 * network built with the seed of the record gives its spikes
+		 * again. The other steps draw their noise as usual
+		 * 
+		 * @return bool false if the file is not a noise file of N neurons
+		 */
+			bool replayNoise(const string& file);
+			
+		/*!
+		 * @brief stop recording or replaying the noise (the record is
+		 * 		  then complete)
+		 */
+			void stopNoise();
+			
 		/*!
 		 * @brief update the state of the network for each time step h
 		 * 
@@ -152,7 +683,142 @@ class Network
 		 * 		  an external random noise or not
 		 */
 			void update();
+			
+		/*!
+		 * @brief choose how the spikes are delivered
+		 * 
+		 * @param delivery_mode mode PUSH (default), PULL or BATCHED
+		 * @param unsigned int workers number of blocks (and of threads
+		 * 		  used by runSimulation) in pull mode, not used by the
+		 * 		  batched mode whose tiles are sized to the cache
+		 * 
+		 * the pull mode is statistically equivalent to the push mode but
+		 * not identical: in push mode a neuron whose clock is late (the
+		 * clock of a neuron stops during the step of each of its spikes)
+		 * can recieve a spike during the very step it is sent, in pull
+		 * mode the spikes are delivered once every neuron is updated.
+		 * With a single worker the external noise is the same as in push
+		 * mode, with more workers each block draws its own.
+		 * The batched mode delivers like the pull mode with one worker
+		 * and gives the same spikes
+		 */
+			void setDeliveryMode(delivery_mode mode, unsigned int workers = 1);
+		
+		/*!
+		 * @brief build the transposed connection map in O(synapses)
+		 * 
+		 * each worker counts and then writes the connections of a range
+		 * of pre-synaptic neurons, so no lock is needed
+		 * 
+		 * @param unsigned int workers number of threads used
+		 */
+			void buildIncoming(unsigned int workers = thread::hardware_concurrency());
+		
+	private:
+	
+		/*!
+		 * @brief split the neurons in blocks and build the connections
+		 * 		  landing in each of them (blocks of pull mode or tiles of
+		 * 		  batched mode)
+		 */
+			void partition(unsigned int workers);
+			
+		/*!
+		 * @brief build again the connections landing in each block after
+		 * 		  the map changed (the blocks keep their neurons, their
+		 * 		  generators and their memory)
+		 */
+			void connectBlocks();
+			
+		/*!
+		 * @brief run the steps start to t_stop-1 of the block b with the
+		 * 		  other workers (pull mode)
+		 */
+			void runBlock(size_t b, unsigned int start, unsigned int t_stop);
+			
+		/*!
+		 * @brief start the threads of the blocks after the first one, or
+		 * 		  stop them (when the blocks change)
+		 */
+			void startWorkers();
+			void stopWorkers();
+			
+		/*!
+		 * @brief update the neurons begin to end-1 and sample their probes
+		 * 
+		 * @param unsigned int t the current step
+		 * @param mt19937 gen, poisson_distribution<int> poisson where
+		 * 		  their external noise is drawn
+		 * @param vector<int>* spikes list of the neurons that spike (pull
+		 * 		  mode), if null the spikes are delivered at once (push mode)
+		 */
+			void updateRange(size_t begin, size_t end, unsigned int t, mt19937& gen,
+							 poisson_distribution<int>& poisson, vector<int>* spikes);
+			
+		/*!
+		 * @brief write in Iext_ the external current of the neurons
+		 * 		  begin to end-1 at step t
+		 */
+			void applyStimuli(size_t begin, size_t end, unsigned int t);
+			
+		/*!
+		 * @brief apply the input commands due at step t (waiting for the
+		 * 		  end of its input in lockstep)
+		 */
+			void receiveInput(unsigned int t);
+			
+		/*!
+		 * @brief end the step t: write the row of the noise recorded and
+		 * 		  publish the spikes listed by the blocks, then the end of
+		 * 		  the step
+		 */
+			void endStep(unsigned int t);
+			
+		/*!
+		 * @brief get the number of external spikes of the neuron i at
+		 * 		  step t, replayed or drawn (and then recorded); like a
+		 * 		  single neuron it only recieves them when it integrates
+		 * 		  its input, otherwise nothing is drawn
+		 */
+			int externalSpikes(size_t i, unsigned int t, mt19937& gen,
+							   poisson_distribution<int>& poisson);
+			
+		/*!
+		 * @brief update a neuron and deliver or list its spike
+		 */
+			void stepNeuron(size_t i, double Iext, double Jext, vector<int>* spikes);
+			
+		/*!
+		 * @brief update the neurons of a block at step t and list the ones
+		 * 		  that spike
+		 */
+			void updateBlock(size_t b, unsigned int t);
+			
+		/*!
+		 * @brief deliver the spikes of step t landing in a block
+		 */
+			void deliverBlock(size_t b, unsigned int t);
+			
+		/*!
+		 * @brief lay the connection map out again, row i getting
+		 * 		  extra[i] + slack free places
+		 */
+			void layout(size_t slack, const vector<int>& extra);
+			
+		/*!
+		 * @brief update what depends on the connection map after it changed
+		 */
+			void rewired();
+			
+		/*!
+		 * @brief potentiate the incoming E->E synapses of an excitatory
+		 * 		  neuron spiking at step t and add the spike to its traces
+		 */
+			void potentiate(size_t post, unsigned int t);
 
 };
 
+//!the network used by default in the simulation
+typedef NetworkT<LIF> Network;
+
 #endif
@@ -13,17 +13,24 @@ using namespace std;
 	//                          //
 	//////////////////////////////
 	
-Neuron::Neuron(neuron_type type) 
-	  :V_(V_reset),
+template <class Model>
+NeuronT<Model>::NeuronT(neuron_type type, Arena* arena) 
+	  :spikeTimes_(ArenaAllocator<double>(arena)),
 	   refractory_(false),
 	   neuroClock_(0),
-	   buffer_(D+1, 0.0),
 	   type_(type)
-{}
+{
+	Model::init(state_);
+	
+	for (int i(0); i<=D; ++i)
+	{
+		buffer_[i] = 0.0;
+	}
+}
 
-Neuron::~Neuron()
+template <class Model>
+NeuronT<Model>::~NeuronT()
 {
-	buffer_.clear();
 	spikeTimes_.clear();
 }
 
@@ -33,28 +40,51 @@ Neuron::~Neuron()
 	//                          //
 	//////////////////////////////
 	
-double Neuron::getMembranePotential() const
+template <class Model>
+double NeuronT<Model>::getMembranePotential() const
 {
-	return V_;
+	return Model::potential(state_);
 }
 
-size_t Neuron::getNumberOfSpike() const
+template <class Model>
+size_t NeuronT<Model>::getNumberOfSpike() const
 {
 	return spikeTimes_.size();
 }
 
-vector<double> Neuron::getSpikeTimes() const
+template <class Model>
+vector<double> NeuronT<Model>::getSpikeTimes() const
+{
+	return vector<double>(spikeTimes_.begin(), spikeTimes_.end());
+}
+
+template <class Model>
+const vector<double, ArenaAllocator<double> >& NeuronT<Model>::getSpikeHistory() const
 {
 	return spikeTimes_;
 }
 
-int Neuron::getBufferPos (int t) const
+template <class Model>
+int NeuronT<Model>::getBufferPos (int t) const
 {
 	int i = t % (D+1);
 	return i;
 }
 
-bool Neuron::isExcitatory()
+template <class Model>
+double NeuronT<Model>::getInput() const
+{
+	return buffer_[getBufferPos(neuroClock_)];
+}
+
+template <class Model>
+bool NeuronT<Model>::integrates() const
+{
+	return ::integrates<Model>(state_, refractory_);
+}
+
+template <class Model>
+bool NeuronT<Model>::isExcitatory()
 {
 	if(type_ == E)
 	{
@@ -72,9 +102,10 @@ bool Neuron::isExcitatory()
 	//                          //
 	//////////////////////////////
 	
-void Neuron::setMembranePotential(double newV)
+template <class Model>
+void NeuronT<Model>::setMembranePotential(double newV)
 {
-	V_ = newV;
+	Model::setPotential(state_, newV);
 }
 
 	//////////////////////////////
@@ -83,83 +114,78 @@ void Neuron::setMembranePotential(double newV)
 	//                          //
 	//////////////////////////////
 
-bool Neuron::update(double Iext, bool randomSpike) 
-{		
-	if(refractory_)
+template <class Model>
+bool NeuronT<Model>::update(double Iext, bool randomSpike) 
+{
+	/*
+	 * the random noise is created with poisson distribution (if enabled),
+	 * only for the steps where the neuron integrates it
+	 */
+	double Jext(0.0);
+	if(randomSpike and integrates())
 	{
-		/*
-		 * during this refractory period the neuron is unable to modify
-		 * its membranne potential: it stays at 0 during 2ms
-		 */
-		
-		//assert(!spikeTimes_.empty());
+		double lambda = V_ext*Ce;
 		
-		if (!spikeTimes_.empty() and neuroClock_>= spikeTimes_.back()+tau_rp)
-		{
-			refractory_ = false;
-		}
+		static random_device rd;
+		static mt19937 gen(rd());
+		static poisson_distribution<int> d(lambda);
+
+		Jext = d(gen)*Je;
 	}
-	else if(!refractory_ and V_ < V_tresh)
-	{
-		/*
-		 * we create a variable J that contain the information comming 
-		 * from the buffer plus the random noise created with poisson
-		 * distribution (if enabled)
-		 */
-		double J(0.0);
-		if(randomSpike)
-		{
-			double lambda = V_ext*Ce;
-			
-			static random_device rd;
-			static mt19937 gen(rd());
-			static poisson_distribution<int> d(lambda);
 	
-			J = d(gen)*Je + buffer_[getBufferPos(neuroClock_)];
-		}
-		else
-		{
-			J = buffer_[getBufferPos(neuroClock_)];
-		}
-		
-		depolarisation(Iext, J);
-	}
-	else if(!refractory_ and V_ >= V_tresh)
-	{
-		spikeTimes_.push_back(neuroClock_);
+	return step(Iext, Jext);
+}
+
+template <class Model>
+bool NeuronT<Model>::step(double Iext, double Jext) 
+{		
+	/*
+	 * the input J contains the information comming from the buffer plus
+	 * the external random noise; during the refractory period (2ms after
+	 * a spike) the neuron is unable to modify its membranne potential
+	 */
+	double& slot = buffer_[getBufferPos(neuroClock_)];
+	double last = refractory_ ? spikeTimes_.back() : 0.0;
 	
-		V_ = V_reset;
-		
-		/*
-		 * after spiking the neuron enter refractory mode
-		 */
-		refractory_ = true;	 
-		
+	if(stepModel<Model>(state_, refractory_, neuroClock_, last, Iext, Jext + slot))
+	{
 		/*
 		 * the neuron gives a signal telling that he spiked
 		 */
+		spikeTimes_.push_back(neuroClock_);
+		
 		return true;
 	}
+	
 	/*
 	 * the buffer is cleaned directly after its use
 	 */
-	buffer_[getBufferPos(neuroClock_)] = 0;
+	slot = 0;
 	
 	++neuroClock_;
 	
 	return false;
 }
 
-void Neuron::depolarisation (double Iext, double J)
+template <class Model>
+void NeuronT<Model>::depolarisation (double Iext, double J)
 {
-	double c = exp(-h/tau);
-	V_ = V_*c + Iext*R*(1-c) + J; 
+	Model::integrate(state_, Iext, J);
 }
 
-void Neuron::setBufferAt(int t, double input)
+template <class Model>
+void NeuronT<Model>::setBufferAt(int t, double input)
 {	
 	int i = getBufferPos(t);
 	buffer_[i] += input;
 }
 
+	//////////////////////////////
+	//                          //
+	//	   Instantiations		//
+	//                          //
+	//////////////////////////////
+
+template class NeuronT<LIF>;
+
 
@@ -2,6 +2,8 @@
 #define neuron_HPP
 
 #include "constant.hpp"
+#include "model.hpp"
+#include "arena.hpp"
 
 #include <vector>
 
@@ -13,16 +15,21 @@ using namespace std;
  * this class simulate the unit of a single neuron and the way it react
  * to extarnal electrical imput, wheter it is a spike comming from an 
  * other neuron or an constant electrical current
+ * 
+ * the dynamics of the neuron are given by the model policy (see model.hpp),
+ * by default a leaky integrate-and-fire neuron
  */
-class Neuron
+template <class Model = LIF>
+class NeuronT
 {		
 	private:
 	
-		//!membrane potential
-		double V_;
+		//!state of the model (membrane potential for a LIF neuron)
+		typename Model::State state_;
 		
 		//!collection of the times when the spikes occured
-		vector<double> spikeTimes_;
+		//!(stored in the arena of the network if it has one)
+		vector<double, ArenaAllocator<double> > spikeTimes_;
 		
 		//!tells if the neuron is refractory or not
 		bool refractory_;
@@ -31,7 +38,8 @@ class Neuron
 		double neuroClock_;
 		
 		//!buffer: memory of the spikes recieved at a time t by the neuron
-		vector<double> buffer_;
+		//!(stored inside the neuron, its size D+1 is known at compile time)
+		double buffer_[D+1];
 
 		//!tells which type the neuron is (E:exitatory, I:inhibitory)
 		neuron_type type_;
@@ -52,14 +60,16 @@ class Neuron
 		 * 		  an empty buffer and in a non spiking state
 		 * 
 		 * @param neuron_type type the type of the neuron
+		 * @param Arena* arena arena where the spike times are stored,
+		 * 		  the heap if null
 		 * 	
 		 */
-		Neuron(neuron_type type);
+		NeuronT(neuron_type type, Arena* arena = nullptr);
 		
 		/*!
 		 * @brief destructor
 		 */	
-		~Neuron();
+		~NeuronT();
 		
 	//////////////////////////////
 	//                          //
@@ -70,7 +80,7 @@ class Neuron
 		/*!
 		 * @brief get the membrane potential of the neuron
 		 * 
-		 * @return double V_
+		 * @return double the membrane potential given by the model
 		 */
 		double getMembranePotential() const;
 		
@@ -88,6 +98,13 @@ class Neuron
 		 * @return vector<double> spikeTimes_
 		 */
 		vector<double> getSpikeTimes() const;
+		
+		/*!
+		 * @brief get the times of the spikes without copying them
+		 * 
+		 * @return the spike times stored in the neuron
+		 */
+		const vector<double, ArenaAllocator<double> >& getSpikeHistory() const;
 	
 		/*!
 		 * @brief tells which position of the buffer correspond to a time t
@@ -98,6 +115,13 @@ class Neuron
 		 */	
 		int getBufferPos (int t) const;
 		
+		/*!
+		 * @brief get the input waiting in the buffer for the current step
+		 * 
+		 * @return double the input
+		 */
+		double getInput() const;
+		
 		/*!
 		 * @brief tells wheter the neuron is excitatory or not (inhibitory)
 		 * 
@@ -106,6 +130,13 @@ class Neuron
 		 */	
 		bool isExcitatory();
 		
+		/*!
+		 * @brief tells if the neuron integrates its input during its next
+		 * 		  step (it is neither refractory nor above the threshold),
+		 * 		  only then is its external noise drawn
+		 */
+		bool integrates() const;
+		
 	//////////////////////////////
 	//                          //
 	//			Setters			//
@@ -131,13 +162,28 @@ class Neuron
 		 * 
 		 * @param double I the external electric current applied on the neuron
 		 * @param bool randomSpike if the neuron recieve random external
-		 * 		  noise or not
+		 * 		  noise or not (it is only drawn when the neuron integrates
+		 * 		  its input, not during the refractory period nor the step
+		 * 		  of a spike)
 		 * 
 		 * @return true if the neuron spike during this update
 		 * 		   false otherwise
 		 */
 		bool update (double Iext, bool randomSpike);
 		
+		/*!
+		 * @brief same as update but with an external noise already drawn
+		 * 		  by the caller (the network draws it with its own seeded
+		 * 		  generator so that a simulation can be reproduced)
+		 * 
+		 * @param double Iext the external electric current applied on the neuron
+		 * @param double Jext the external input recieved during this step
+		 * 
+		 * @return true if the neuron spike during this update
+		 * 		   false otherwise
+		 */
+		bool step (double Iext, double Jext);
+		
 		/*!
 		 * @brief compute the embrane potential at time t+h
 		 * 
@@ -156,4 +202,7 @@ class Neuron
 		void setBufferAt (int t, double input);
 };
 
+//!the neuron used by default in the simulation
+typedef NeuronT<LIF> Neuron;
+
 #endif
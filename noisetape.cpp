@@ -0,0 +1,222 @@
+#include "noisetape.hpp"
+
+#include <iostream>
+#include <cstring>
+#include <cmath>
+#include <algorithm>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+using namespace std;
+
+//version of the format written
+static const uint32_t noiseVersion(1);
+
+//numbers under the mean given by a byte
+static const int noiseBelow(127);
+
+	//////////////////////////////
+	//                          //
+	//			Recorder		//
+	//                          //
+	//////////////////////////////
+
+NoiseRecorder::NoiseRecorder(const string& file, unsigned int neurons, unsigned int start, double mean)
+		:file_(file.c_str(), ios::binary),
+		 counts_(neurons, 0),
+		 row_(neurons, 0)
+{
+	memset(&header_, 0, sizeof(NoiseHeader));
+	memcpy(header_.magic, "NOISETAP", 8);
+	header_.version = noiseVersion;
+	header_.neurons = neurons;
+	header_.start = start;
+	header_.steps = 0;
+	header_.base = max(int(round(mean)) - noiseBelow, 0);
+	header_.exceptions = 0;
+	counts_.assign(neurons, header_.base);
+
+	if(file_.fail())
+	{
+		cerr << "Error while opening the file " << file << endl;
+		return;
+	}
+
+	//the header is written again once the number of steps is known
+	file_.write(reinterpret_cast<const char*>(&header_), sizeof(NoiseHeader));
+}
+
+NoiseRecorder::~NoiseRecorder()
+{
+	close();
+}
+
+bool NoiseRecorder::isOpen() const
+{
+	return file_.is_open() and !file_.fail();
+}
+
+void NoiseRecorder::endStep()
+{
+	if(!isOpen())
+	{
+		return;
+	}
+
+	int base = header_.base;
+	for (size_t i(0); i<counts_.size(); ++i)
+	{
+		int b = counts_[i]-base;
+		if(b >= 0 and b < noiseEscape)
+		{
+			row_[i] = b;
+		}
+		else
+		{
+			row_[i] = noiseEscape;
+			NoiseException e = {header_.start+header_.steps, uint32_t(i), uint32_t(counts_[i])};
+			exceptions_.push_back(e);
+		}
+	}
+
+	file_.write(reinterpret_cast<const char*>(row_.data()), row_.size());
+	++header_.steps;
+	
+	counts_.assign(counts_.size(), base);
+}
+
+bool NoiseRecorder::close()
+{
+	if(!file_.is_open())
+	{
+		return false;
+	}
+
+	bool ok = !file_.fail();
+	if(ok)
+	{
+		static const char padding[4] = {0, 0, 0, 0};
+		size_t rows = size_t(header_.steps)*header_.neurons;
+		file_.write(padding, (4 - rows%4)%4);
+
+		header_.exceptions = exceptions_.size();
+		file_.write(reinterpret_cast<const char*>(exceptions_.data()),
+					exceptions_.size()*sizeof(NoiseException));
+
+		file_.seekp(0);
+		file_.write(reinterpret_cast<const char*>(&header_), sizeof(NoiseHeader));
+		ok = !file_.fail();
+	}
+
+	file_.close();
+	return ok;
+}
+
+	//////////////////////////////
+	//                          //
+	//			 Tape			//
+	//                          //
+	//////////////////////////////
+
+NoiseTape::NoiseTape(const string& file)
+		:data_(nullptr),
+		 size_(0),
+		 header_(nullptr),
+		 rows_(nullptr),
+		 exceptions_(nullptr)
+{
+	int fd = open(file.c_str(), O_RDONLY);
+	struct stat info;
+	if(fd < 0 or fstat(fd, &info) != 0)
+	{
+		cerr << "Error while opening the file " << file << endl;
+		if(fd >= 0)
+		{
+			close(fd);
+		}
+		return;
+	}
+
+	size_t size = info.st_size;
+	if(size < sizeof(NoiseHeader))
+	{
+		cerr << "ERROR: " << file << " is not a noise file" << endl;
+		close(fd);
+		return;
+	}
+
+	void* map = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if(map == MAP_FAILED)
+	{
+		cerr << "Error while mapping the file " << file << endl;
+		return;
+	}
+
+	const char* data = static_cast<const char*>(map);
+	const NoiseHeader* header = reinterpret_cast<const NoiseHeader*>(data);
+
+	//the size of the file has to match the one given by its header
+	size_t rows = size_t(header->steps)*header->neurons;
+	size_t expected = sizeof(NoiseHeader) + rows + (4 - rows%4)%4
+					+ header->exceptions*sizeof(NoiseException);
+
+	if(memcmp(header->magic, "NOISETAP", 8) != 0 or header->version != noiseVersion
+	   or expected != size)
+	{
+		cerr << "ERROR: " << file << " is not a noise file" << endl;
+		munmap(map, size);
+		return;
+	}
+
+	//the rows are read one after the other
+	madvise(map, size, MADV_SEQUENTIAL);
+
+	data_ = data;
+	size_ = size;
+	header_ = header;
+	rows_ = reinterpret_cast<const uint8_t*>(data + sizeof(NoiseHeader));
+	exceptions_ = reinterpret_cast<const NoiseException*>(data + size - header->exceptions*sizeof(NoiseException));
+}
+
+NoiseTape::~NoiseTape()
+{
+	if(data_ != nullptr)
+	{
+		munmap(const_cast<char*>(data_), size_);
+	}
+}
+
+bool NoiseTape::isOpen() const
+{
+	return data_ != nullptr;
+}
+
+unsigned int NoiseTape::getNumberOfNeurons() const
+{
+	return isOpen() ? header_->neurons : 0;
+}
+
+unsigned int NoiseTape::getStart() const
+{
+	return isOpen() ? header_->start : 0;
+}
+
+unsigned int NoiseTape::getNumberOfSteps() const
+{
+	return isOpen() ? header_->steps : 0;
+}
+
+int NoiseTape::exception(unsigned int t, size_t neuron) const
+{
+	const NoiseException* end = exceptions_ + header_->exceptions;
+	const NoiseException* e = lower_bound(exceptions_, end, make_pair(t, neuron),
+		[](const NoiseException& x, const pair<unsigned int, size_t>& key)
+		{
+			return x.step < key.first or (x.step == key.first and x.neuron < key.second);
+		});
+
+	return (e != end and e->step == t and e->neuron == neuron) ? int(e->count) : 0;
+}
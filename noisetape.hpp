@@ -0,0 +1,213 @@
+#ifndef noisetape_HPP
+#define noisetape_HPP
+
+#include <vector>
+#include <string>
+#include <fstream>
+#include <cstdint>
+#include <cstddef>
+
+using namespace std;
+
+/*
+ * record of the external noise of a simulation
+ *
+ * the noise of a neuron in a step is its number of external spikes (a
+ * Poisson draw of mean V_ext*Ce). A NoiseRecorder writes these numbers
+ * step after step in a binary file, and a NoiseTape maps the file to give
+ * them back, so that later runs recieve the same input without drawing a
+ * random number (see NetworkT::recordNoise and NetworkT::replayNoise).
+ *
+ * the file is made of:
+ * 	- a header (see NoiseHeader)
+ * 	- one row per step of one byte per neuron: the number of spikes minus
+ * 	  the base of the header, or noiseEscape if it does not fit in a byte
+ * 	- padding up to a multiple of 4 bytes
+ * 	- the numbers that did not fit (see NoiseException), sorted by step
+ * 	  and neuron
+ *
+ * the base is chosen from the mean so that the bytes cover about 9
+ * standard deviations on each side, the exceptions are thus very rare.
+ * All the numbers are written in the byte order of the machine
+ *
+ * a row takes one byte per neuron, whether the neuron drew its noise or
+ * not: in its standard size (N = 12500, h = 0.1ms) a record grows by
+ * 125MB per simulated second (1.25GB for a run of 10s). A smaller code
+ * cannot hold the noise: with a mean of 200 spikes the standard deviation
+ * is 14, and 4 bits would only cover half of it on each side, most of the
+ * numbers would be exceptions
+ */
+
+//!byte of a number given in the exceptions
+static const uint8_t noiseEscape(255);
+
+/*!
+ * @brief beginning of a noise file
+ */
+struct NoiseHeader
+{
+	//!"NOISETAP"
+	char magic[8];
+
+	//!version of the format
+	uint32_t version;
+
+	//!number of neurons of a row
+	uint32_t neurons;
+
+	//!first step recorded and number of steps
+	uint32_t start, steps;
+
+	//!number of spikes given by the byte 0
+	uint32_t base;
+
+	//!number of exceptions
+	uint32_t exceptions;
+};
+
+/*!
+ * @brief number of spikes that did not fit in its byte
+ */
+struct NoiseException
+{
+	uint32_t step, neuron, count;
+};
+
+/*!
+ * @brief noise recorder class
+ *
+ * the network writes the number of spikes of each neuron with set (the
+ * neurons can be set by several threads, each its own) and ends each step
+ * with endStep, which writes the row. The file is complete once the
+ * recorder is closed
+ */
+class NoiseRecorder
+{
+	private:
+
+		ofstream file_;
+
+		NoiseHeader header_;
+
+		//!numbers of spikes of the current step
+		vector<int> counts_;
+
+		//!row of the current step
+		vector<uint8_t> row_;
+
+		vector<NoiseException> exceptions_;
+
+		//!a recorder cannot be copied (it owns its file)
+		NoiseRecorder(const NoiseRecorder&) = delete;
+		NoiseRecorder& operator=(const NoiseRecorder&) = delete;
+
+	public:
+
+		/*!
+		 * @brief open the file of a new record
+		 *
+		 * @param string file name of the file
+		 * @param unsigned int neurons number of neurons
+		 * @param unsigned int start first step recorded
+		 * @param double mean mean number of spikes of a neuron in a step
+		 */
+		NoiseRecorder(const string& file, unsigned int neurons, unsigned int start, double mean);
+
+		/*!
+		 * @brief close the file
+		 */
+		~NoiseRecorder();
+
+		bool isOpen() const;
+
+		/*!
+		 * @brief give the number of spikes of a neuron in the current step
+		 * 		  (a neuron not given in a step, since it did not recieve
+		 * 		  any noise, is written as the base)
+		 */
+		void set(size_t neuron, int count)
+		{
+			counts_[neuron] = count;
+		}
+
+		/*!
+		 * @brief write the row of the current step
+		 */
+		void endStep();
+
+		/*!
+		 * @brief write the exceptions and the final header
+		 *
+		 * @return bool false if the file could not be written
+		 */
+		bool close();
+};
+
+/*!
+ * @brief noise tape class
+ *
+ * this class maps a noise file in memory and gives back the number of
+ * spikes of a neuron in a step; the rows are read in order, so the pages
+ * are read ahead by the system
+ */
+class NoiseTape
+{
+	private:
+
+		//!mapped file (null if the file could not be opened)
+		const char* data_;
+
+		//!size of the mapped file
+		size_t size_;
+
+		//!parts of the mapped file
+		const NoiseHeader* header_;
+		const uint8_t* rows_;
+		const NoiseException* exceptions_;
+
+		/*!
+		 * @brief get a number of spikes given in the exceptions
+		 */
+		int exception(unsigned int t, size_t neuron) const;
+
+		//!a tape cannot be copied (it owns its mapping)
+		NoiseTape(const NoiseTape&) = delete;
+		NoiseTape& operator=(const NoiseTape&) = delete;
+
+	public:
+
+		/*!
+		 * @brief map a noise file (the tape is not open if the file is
+		 * 		  not a valid noise file)
+		 */
+		NoiseTape(const string& file);
+
+		~NoiseTape();
+
+		bool isOpen() const;
+
+		unsigned int getNumberOfNeurons() const;
+
+		//!first step recorded and number of steps
+		unsigned int getStart() const;
+		unsigned int getNumberOfSteps() const;
+
+		/*!
+		 * @brief tells if the step t is recorded
+		 */
+		bool hasStep(unsigned int t) const
+		{
+			return t-header_->start < header_->steps;
+		}
+
+		/*!
+		 * @brief get the number of spikes of a neuron in a recorded step
+		 */
+		int get(unsigned int t, size_t neuron) const
+		{
+			uint8_t b = rows_[size_t(t-header_->start)*header_->neurons + neuron];
+			return (b != noiseEscape) ? int(header_->base + b) : exception(t, neuron);
+		}
+};
+
+#endif
@@ -0,0 +1,165 @@
+#include "progress.hpp"
+
+#include <sstream>
+#include <iomanip>
+#include <signal.h>
+
+using namespace std;
+
+//number of signals recieved since enableSignal
+static volatile sig_atomic_t signalRequests(0);
+
+static void onSignal(int)
+{
+	signalRequests = signalRequests + 1;
+}
+
+	//////////////////////////////
+	//                          //
+	// constructor & destructor //
+	//                          //
+	//////////////////////////////
+
+template <class Model>
+ProgressReporterT<Model>::ProgressReporterT(NetworkT<Model>& net, double interval, ostream& out)
+		:net_(net),
+		 interval_(interval),
+		 out_(out),
+		 stop_(false),
+		 start_(chrono::steady_clock::now()),
+		 last_(start_),
+		 signals_(signalRequests)
+{
+	typename NetworkT<Model>::Status s = net_.getStatus();
+	lastClock_ = s.clock;
+	lastSpikes_ = s.spikes;
+
+	//the thread is started once every member is initialised
+	thread_ = thread(&ProgressReporterT<Model>::loop, this);
+}
+
+template <class Model>
+ProgressReporterT<Model>::~ProgressReporterT()
+{
+	{
+		lock_guard<mutex> lock(mutex_);
+		stop_ = true;
+	}
+	cv_.notify_all();
+	thread_.join();
+}
+
+	//////////////////////////////
+	//                          //
+	//			Reports			//
+	//                          //
+	//////////////////////////////
+
+template <class Model>
+string ProgressReporterT<Model>::report()
+{
+	typename NetworkT<Model>::Status s = net_.getStatus();
+	chrono::steady_clock::time_point now = chrono::steady_clock::now();
+
+	lock_guard<mutex> lock(mutex_);
+
+	double elapsed = chrono::duration<double>(now-last_).count();
+	unsigned int steps = s.clock-lastClock_;
+	double speed = (elapsed > 0) ? steps/elapsed : 0.0;
+	double rate = (steps > 0) ? (s.spikes-lastSpikes_)/(N*steps*h_ms/1000) : 0.0;
+
+	ostringstream line;
+	line << fixed << setprecision(1);
+	line << "step " << s.clock << "/" << s.stop;
+	if(s.stop > 0)
+	{
+		line << " (" << 100.0*s.clock/s.stop << "%)";
+	}
+	line << "  " << speed << " steps/s";
+	if(s.clock < s.stop and speed > 0)
+	{
+		line << "  left " << (s.stop-s.clock)/speed << "s";
+	}
+	line << "  rate " << rate << "Hz";
+	line << "  memory " << s.footprint/(1024*1024) << "MB";
+
+	last_ = now;
+	lastClock_ = s.clock;
+	lastSpikes_ = s.spikes;
+
+	return line.str();
+}
+
+template <class Model>
+string ProgressReporterT<Model>::status()
+{
+	typename NetworkT<Model>::Status s = net_.getStatus();
+	double elapsed = chrono::duration<double>(chrono::steady_clock::now()-start_).count();
+
+	ostringstream line;
+	line << fixed << setprecision(1);
+	line << "status: step " << s.clock << "/" << s.stop
+		 << ", elapsed " << elapsed << "s"
+		 << ", spikes " << s.spikes
+		 << ", mean rate " << ((s.clock > 0) ? s.spikes/(N*s.clock*h_ms/1000) : 0.0) << "Hz"
+		 << ", memory " << s.footprint/(1024*1024) << "MB";
+
+	return line.str();
+}
+
+template <class Model>
+void ProgressReporterT<Model>::enableSignal(int signal)
+{
+	/*
+	 * the handler only counts the signals, the reporters write their
+	 * status from their own thread; the interrupted system calls of the
+	 * simulation are restarted
+	 */
+	struct sigaction action;
+	action.sa_handler = onSignal;
+	sigemptyset(&action.sa_mask);
+	action.sa_flags = SA_RESTART;
+	sigaction(signal, &action, nullptr);
+}
+
+template <class Model>
+void ProgressReporterT<Model>::loop()
+{
+	unique_lock<mutex> lock(mutex_);
+
+	while(!stop_)
+	{
+		//the signals are answered within 100ms
+		cv_.wait_for(lock, chrono::milliseconds(100));
+		if(stop_)
+		{
+			break;
+		}
+
+		bool answer = (signalRequests != signals_);
+		signals_ = signalRequests;
+
+		bool due = interval_ > 0
+				   and chrono::duration<double>(chrono::steady_clock::now()-last_).count() >= interval_;
+
+		//report and status lock the reporter themselves
+		lock.unlock();
+		if(answer)
+		{
+			out_ << status() << endl;
+		}
+		if(due)
+		{
+			out_ << report() << endl;
+		}
+		lock.lock();
+	}
+}
+
+	//////////////////////////////
+	//                          //
+	//	   Instantiations		//
+	//                          //
+	//////////////////////////////
+
+template class ProgressReporterT<LIF>;
@@ -0,0 +1,124 @@
+#ifndef progress_HPP
+#define progress_HPP
+
+#include "network.hpp"
+
+#include <iostream>
+#include <string>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <csignal>
+
+using namespace std;
+
+/*!
+ * @brief progress reporter class
+ *
+ * this class follows a long simulation from an other thread: every
+ * interval it writes the step reached, the speed of the simulation, the
+ * time left, the population rate and the memory used. The simulation only
+ * publishes its clock and its spike count once per step (see
+ * NetworkT::getStatus), it is not slowed down by the reporter.
+ *
+ * once enableSignal is called a signal (SIGUSR1 by default) sent to the
+ * process makes every reporter write a full status at once, without
+ * stopping the simulation:
+ * 	kill -USR1 <pid>
+ */
+template <class Model = LIF>
+class ProgressReporterT
+{
+	private:
+
+		//!network followed
+		NetworkT<Model>& net_;
+
+		//!time between two reports [s] (0: only on signal)
+		double interval_;
+
+		//!where the reports are written
+		ostream& out_;
+
+		//!thread writing the reports
+		thread thread_;
+
+		//!protects the state below and wakes the thread when it stops
+		mutex mutex_;
+		condition_variable cv_;
+		bool stop_;
+
+		//!time of the creation of the reporter and of the last report
+		chrono::steady_clock::time_point start_, last_;
+
+		//!clock and spikes of the network at the last report
+		unsigned int lastClock_;
+		size_t lastSpikes_;
+
+		//!signals already answered
+		int signals_;
+
+		/*!
+		 * @brief loop of the thread: wakes up regularly to answer the
+		 * 		  signals and to write the reports
+		 */
+		void loop();
+
+		//!a reporter cannot be copied (it owns its thread)
+		ProgressReporterT(const ProgressReporterT&) = delete;
+		ProgressReporterT& operator=(const ProgressReporterT&) = delete;
+
+	public:
+
+	//////////////////////////////
+	//                          //
+	// constructor & destructor //
+	//                          //
+	//////////////////////////////
+
+		/*!
+		 * @brief start following a network
+		 *
+		 * @param NetworkT<Model> net the network, it has to outlive the
+		 * 		  reporter
+		 * @param double interval time between two reports [s]
+		 * @param ostream out where the reports are written
+		 */
+		ProgressReporterT(NetworkT<Model>& net, double interval = 10.0, ostream& out = cerr);
+
+		/*!
+		 * @brief destructor, stops the thread of the reporter
+		 */
+		~ProgressReporterT();
+
+	//////////////////////////////
+	//                          //
+	//			Reports			//
+	//                          //
+	//////////////////////////////
+
+		/*!
+		 * @brief get a report since the previous one: step, speed, time
+		 * 		  left, population rate and memory
+		 */
+		string report();
+
+		/*!
+		 * @brief get the full status of the simulation since its beginning
+		 */
+		string status();
+
+		/*!
+		 * @brief make the reporters write their status when the process
+		 * 		  recieves a signal
+		 *
+		 * @param int signal the signal (SIGUSR1 by default)
+		 */
+		static void enableSignal(int signal = SIGUSR1);
+};
+
+//!the reporter of the network used by default
+typedef ProgressReporterT<LIF> ProgressReporter;
+
+#endif
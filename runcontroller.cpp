@@ -0,0 +1,218 @@
+#include "runcontroller.hpp"
+
+#include <cmath>
+#include <algorithm>
+
+using namespace std;
+
+	//////////////////////////////
+	//                          //
+	//		  constructor		//
+	//                          //
+	//////////////////////////////
+
+template <class Model>
+RunControllerT<Model>::RunControllerT(NetworkT<Model>& net, unsigned int window, unsigned int batch)
+		:net_(net),
+		 window_(window > 0 ? window : 1),
+		 batch_(batch > 0 ? batch : 1),
+		 silence_(0.1),
+		 //90% of the rate of a neuron spiking at the end of each refractory period
+		 blowUp_(0.9*1000/(tau_rp*h_ms)),
+		 tolerance_(0.05),
+		 recordSteady_(false),
+		 target_(0),
+		 reason_(TIME_LIMIT),
+		 stopTime_(0),
+		 steadyTime_(0),
+		 recordStart_(0),
+		 recorded_(0)
+{}
+
+	//////////////////////////////
+	//                          //
+	//			Setters			//
+	//                          //
+	//////////////////////////////
+
+template <class Model>
+void RunControllerT<Model>::setSilence(double rate)
+{
+	silence_ = rate;
+}
+
+template <class Model>
+void RunControllerT<Model>::setBlowUp(double rate)
+{
+	blowUp_ = rate;
+}
+
+template <class Model>
+void RunControllerT<Model>::setSteadyState(double tolerance, bool record)
+{
+	tolerance_ = tolerance;
+	recordSteady_ = record;
+}
+
+template <class Model>
+void RunControllerT<Model>::setTargetSpikes(size_t spikes)
+{
+	target_ = spikes;
+}
+
+	//////////////////////////////
+	//                          //
+	//		  Simulation		//
+	//                          //
+	//////////////////////////////
+
+template <class Model>
+stop_reason RunControllerT<Model>::run(unsigned int t_max)
+{
+	reason_ = TIME_LIMIT;
+	steadyTime_ = 0;
+	recordStart_ = net_.getClock();
+	rates_.clear();
+
+	size_t last = net_.getNumberOfSpike(),
+		   first = last;
+
+	//sum of the rates of the current batch and mean of the previous one
+	double sum(0.0),
+		   previous(-1.0);
+	unsigned int count(0);
+
+	bool recording = !recordSteady_ or tolerance_ <= 0;
+
+	while(net_.getClock() < t_max)
+	{
+		unsigned int start = net_.getClock(),
+					 stop = min(start+window_, t_max);
+
+		net_.runSimulation(stop);
+
+		size_t total = net_.getNumberOfSpike();
+		double rate = (total-last)/(N*(stop-start)*h_ms/1000);
+		last = total;
+		rates_.push_back(rate);
+
+		if(rate > blowUp_)
+		{
+			reason_ = BLOW_UP;
+			break;
+		}
+
+		sum += rate;
+		if(++count == batch_)
+		{
+			double mean = sum/batch_;
+
+			if(mean < silence_)
+			{
+				reason_ = SILENCE;
+				break;
+			}
+
+			if(steadyTime_ == 0 and previous >= 0 and tolerance_ > 0
+			   and fabs(mean-previous) <= tolerance_*max(mean, previous))
+			{
+				steadyTime_ = stop;
+
+				if(!recordSteady_)
+				{
+					reason_ = STEADY_STATE;
+					break;
+				}
+
+				recording = true;
+				recordStart_ = stop;
+				first = total;
+			}
+
+			previous = mean;
+			sum = 0.0;
+			count = 0;
+		}
+
+		if(recording and target_ > 0 and total-first >= target_)
+		{
+			reason_ = SAMPLE_SIZE;
+			break;
+		}
+	}
+
+	stopTime_ = net_.getClock();
+	recorded_ = recording ? last-first : 0;
+
+	return reason_;
+}
+
+	//////////////////////////////
+	//                          //
+	//			Getters			//
+	//                          //
+	//////////////////////////////
+
+template <class Model>
+stop_reason RunControllerT<Model>::getReason() const
+{
+	return reason_;
+}
+
+template <class Model>
+string RunControllerT<Model>::getReasonName() const
+{
+	switch(reason_)
+	{
+		case TIME_LIMIT:
+			return "time limit";
+		case STEADY_STATE:
+			return "steady state";
+		case SILENCE:
+			return "silence";
+		case BLOW_UP:
+			return "blow-up";
+		case SAMPLE_SIZE:
+			return "sample size";
+	}
+
+	return "";
+}
+
+template <class Model>
+unsigned int RunControllerT<Model>::getStopTime() const
+{
+	return stopTime_;
+}
+
+template <class Model>
+unsigned int RunControllerT<Model>::getSteadyTime() const
+{
+	return steadyTime_;
+}
+
+template <class Model>
+unsigned int RunControllerT<Model>::getRecordStart() const
+{
+	return recordStart_;
+}
+
+template <class Model>
+size_t RunControllerT<Model>::getRecordedSpikes() const
+{
+	return recorded_;
+}
+
+template <class Model>
+vector<double> RunControllerT<Model>::getRates() const
+{
+	return rates_;
+}
+
+	//////////////////////////////
+	//                          //
+	//	   Instantiations		//
+	//                          //
+	//////////////////////////////
+
+template class RunControllerT<LIF>;
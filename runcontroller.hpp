@@ -0,0 +1,193 @@
+#ifndef runcontroller_HPP
+#define runcontroller_HPP
+
+#include "network.hpp"
+
+#include <vector>
+#include <string>
+
+using namespace std;
+
+/*
+ * tells why a controlled run stopped:
+ * TIME_LIMIT: the maximal step was reached
+ * STEADY_STATE: the population rate became stationary
+ * SILENCE: the population stopped spiking
+ * BLOW_UP: the population fires close to its maximal rate
+ * SAMPLE_SIZE: enough spikes were recorded
+ */
+enum stop_reason{TIME_LIMIT, STEADY_STATE, SILENCE, BLOW_UP, SAMPLE_SIZE};
+
+/*!
+ * @brief run controller class
+ *
+ * this class runs a network window after window and follows its population
+ * rate, so that a simulation whose outcome is already known can stop
+ * before its maximal duration.
+ *
+ * the windows are grouped in batches: a batch whose mean rate is under
+ * the silence rate stops the run, as well as a single window above the
+ * blow-up rate. The rate is stationary once the means of two consecutive
+ * batches differ by less than the tolerance; the run then either stops or
+ * starts recording until the wanted number of spikes is reached.
+ *
+ * it only reads the spike count of the network between two windows, the
+ * update of the neurons is not slowed down
+ */
+template <class Model = LIF>
+class RunControllerT
+{
+	private:
+
+		//!network simulated
+		NetworkT<Model>& net_;
+
+		//!duration of a window !in steps h!
+		unsigned int window_;
+
+		//!number of windows in a batch
+		unsigned int batch_;
+
+		//!rates [Hz] under which the network is silent and above which
+		//!it blew up
+		double silence_, blowUp_;
+
+		//!relative difference of two batches accepted as stationary
+		double tolerance_;
+
+		//!if true the steady state starts the recording instead of
+		//!stopping the run
+		bool recordSteady_;
+
+		//!number of spikes to record (0: no target)
+		size_t target_;
+
+		//!why the last run stopped
+		stop_reason reason_;
+
+		//!step at which the last run stopped
+		unsigned int stopTime_;
+
+		//!step at which the rate became stationary (0 if it did not)
+		unsigned int steadyTime_;
+
+		//!step at which the recording started
+		unsigned int recordStart_;
+
+		//!number of spikes since the beginning of the recording
+		size_t recorded_;
+
+		//!mean rate [Hz] of each window of the last run
+		vector<double> rates_;
+
+	public:
+
+	//////////////////////////////
+	//                          //
+	//		  constructor		//
+	//                          //
+	//////////////////////////////
+
+		/*!
+		 * @brief initialise a controller of a network
+		 *
+		 * @param NetworkT<Model> net the network, it has to outlive the
+		 * 		  controller
+		 * @param unsigned int window duration of a window (10ms by default)
+		 * @param unsigned int batch number of windows in a batch
+		 */
+		RunControllerT(NetworkT<Model>& net, unsigned int window = 100, unsigned int batch = 10);
+
+	//////////////////////////////
+	//                          //
+	//			Setters			//
+	//                          //
+	//////////////////////////////
+
+		/*!
+		 * @brief set the rate [Hz] under which a batch is silent
+		 */
+		void setSilence(double rate);
+
+		/*!
+		 * @brief set the rate [Hz] above which a window blew up
+		 */
+		void setBlowUp(double rate);
+
+		/*!
+		 * @brief set the criterion of the steady state
+		 *
+		 * @param double tolerance relative difference between the mean
+		 * 		  rates of two consecutive batches (0 disables it)
+		 * @param bool record if true the run goes on and only the spikes
+		 * 		  after the steady state are counted in the sample
+		 */
+		void setSteadyState(double tolerance, bool record = false);
+
+		/*!
+		 * @brief set the number of spikes after which the run stops
+		 * 		  (0 disables it)
+		 */
+		void setTargetSpikes(size_t spikes);
+
+	//////////////////////////////
+	//                          //
+	//		  Simulation		//
+	//                          //
+	//////////////////////////////
+
+		/*!
+		 * @brief run the network until one of the criteria is met or
+		 * 		  until the step t_max
+		 *
+		 * @return stop_reason why the run stopped
+		 */
+		stop_reason run(unsigned int t_max);
+
+	//////////////////////////////
+	//                          //
+	//			Getters			//
+	//                          //
+	//////////////////////////////
+
+		/*!
+		 * @brief get why the last run stopped
+		 */
+		stop_reason getReason() const;
+
+		/*!
+		 * @brief get the reason of the last run as a word
+		 */
+		string getReasonName() const;
+
+		/*!
+		 * @brief get the step at which the last run stopped
+		 */
+		unsigned int getStopTime() const;
+
+		/*!
+		 * @brief get the step at which the rate became stationary (0 if
+		 * 		  it did not)
+		 */
+		unsigned int getSteadyTime() const;
+
+		/*!
+		 * @brief get the step from which the spikes are recorded
+		 */
+		unsigned int getRecordStart() const;
+
+		/*!
+		 * @brief get the number of spikes recorded during the last run
+		 */
+		size_t getRecordedSpikes() const;
+
+		/*!
+		 * @brief get the mean rate [Hz] of each window of the last run
+		 */
+		vector<double> getRates() const;
+};
+
+//!the controller of the network used by default
+typedef RunControllerT<LIF> RunController;
+
+#endif
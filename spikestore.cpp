@@ -0,0 +1,285 @@
+#include "spikestore.hpp"
+
+#include <iostream>
+#include <fstream>
+#include <cstring>
+#include <algorithm>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+using namespace std;
+
+//version of the format written
+static const uint32_t storeVersion(2);
+
+//number of spikes copied in the file at once by the writer
+static const size_t writeChunk(1 << 16);
+
+	//////////////////////////////
+	//                          //
+	// constructor & destructor //
+	//                          //
+	//////////////////////////////
+
+SpikeStore::SpikeStore(const string& file)
+		:data_(nullptr),
+		 size_(0),
+		 header_(nullptr),
+		 counts_(nullptr),
+		 offsets_(nullptr),
+		 records_(nullptr)
+{
+	int fd = open(file.c_str(), O_RDONLY);
+	struct stat info;
+	if(fd < 0 or fstat(fd, &info) != 0)
+	{
+		cerr << "Error while opening the file " << file << endl;
+		if(fd >= 0)
+		{
+			close(fd);
+		}
+		return;
+	}
+
+	size_t size = info.st_size;
+	if(size < sizeof(Header))
+	{
+		cerr << "ERROR: " << file << " is not a spike store" << endl;
+		close(fd);
+		return;
+	}
+
+	void* map = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if(map == MAP_FAILED)
+	{
+		cerr << "Error while mapping the file " << file << endl;
+		return;
+	}
+
+	const char* data = static_cast<const char*>(map);
+	const Header* header = reinterpret_cast<const Header*>(data);
+
+	//the size of the file has to match the one given by its header
+	size_t expected = sizeof(Header)
+					+ (size_t(header->neurons)*(header->blocks + 1) + 1)*sizeof(uint64_t)
+					+ header->spikes*sizeof(Record);
+
+	if(memcmp(header->magic, "SPKSTORE", 8) != 0 or header->version != storeVersion
+	   or expected != size)
+	{
+		cerr << "ERROR: " << file << " is not a spike store" << endl;
+		munmap(map, size);
+		return;
+	}
+
+	//the queries only read a few blocks of the file
+	madvise(map, size, MADV_RANDOM);
+
+	data_ = data;
+	size_ = size;
+	header_ = header;
+	counts_ = reinterpret_cast<const uint64_t*>(data + sizeof(Header));
+	offsets_ = counts_ + header->neurons;
+	records_ = reinterpret_cast<const Record*>(offsets_ + size_t(header->neurons)*header->blocks + 1);
+}
+
+SpikeStore::~SpikeStore()
+{
+	if(data_ != nullptr)
+	{
+		munmap(const_cast<char*>(data_), size_);
+	}
+}
+
+	//////////////////////////////
+	//                          //
+	//			Writer			//
+	//                          //
+	//////////////////////////////
+
+bool SpikeStore::write(const string& file, const vector< vector<double> >& spikes,
+					   unsigned int duration, unsigned int block)
+{
+	if(block == 0)
+	{
+		block = 1;
+	}
+
+	//the last spike can be after the given duration
+	for (size_t i(0); i<spikes.size(); ++i)
+	{
+		if(!spikes[i].empty())
+		{
+			duration = max(duration, (unsigned int)(spikes[i].back())+1);
+		}
+	}
+
+	Header header;
+	memset(&header, 0, sizeof(Header));
+	memcpy(header.magic, "SPKSTORE", 8);
+	header.version = storeVersion;
+	header.neurons = spikes.size();
+	header.duration = duration;
+	header.block = block;
+	header.blocks = (duration+block-1)/block;
+	header.spikes = 0;
+
+	/*
+	 * a first pass counts the spikes of each neuron and of each neuron in
+	 * each block to build the index, a second one copies the spikes block
+	 * after block, and in a block neuron after neuron
+	 */
+	size_t nn = header.neurons;
+	vector<uint64_t> counts(nn, 0),
+					 offsets(nn*header.blocks + 1, 0);
+
+	for (size_t i(0); i<nn; ++i)
+	{
+		counts[i] = spikes[i].size();
+		header.spikes += counts[i];
+
+		for (size_t k(0); k<spikes[i].size(); ++k)
+		{
+			++offsets[(size_t(spikes[i][k])/block)*nn + i + 1];
+		}
+	}
+	for (size_t c(1); c<offsets.size(); ++c)
+	{
+		offsets[c] += offsets[c-1];
+	}
+
+	ofstream data(file.c_str(), ios::binary);
+	if(data.fail())
+	{
+		cerr << "Error while opening the file " << file << endl;
+		return false;
+	}
+
+	data.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+	data.write(reinterpret_cast<const char*>(counts.data()), counts.size()*sizeof(uint64_t));
+	data.write(reinterpret_cast<const char*>(offsets.data()), offsets.size()*sizeof(uint64_t));
+
+	//next spike of each neuron to copy
+	vector<size_t> next(nn, 0);
+	vector<Record> chunk;
+	chunk.reserve(writeChunk);
+
+	for (size_t b(0); b<header.blocks; ++b)
+	{
+		double stop = double(b+1)*block;
+
+		for (size_t i(0); i<nn; ++i)
+		{
+			size_t& k = next[i];
+
+			while(k < spikes[i].size() and spikes[i][k] < stop)
+			{
+				Record r = {uint32_t(i), uint32_t(spikes[i][k++])};
+				chunk.push_back(r);
+
+				if(chunk.size() == writeChunk)
+				{
+					data.write(reinterpret_cast<const char*>(chunk.data()), chunk.size()*sizeof(Record));
+					chunk.clear();
+				}
+			}
+		}
+	}
+	data.write(reinterpret_cast<const char*>(chunk.data()), chunk.size()*sizeof(Record));
+
+	return !data.fail();
+}
+
+	//////////////////////////////
+	//                          //
+	//			Getters			//
+	//                          //
+	//////////////////////////////
+
+bool SpikeStore::isOpen() const
+{
+	return data_ != nullptr;
+}
+
+unsigned int SpikeStore::getNumberOfNeurons() const
+{
+	return isOpen() ? header_->neurons : 0;
+}
+
+unsigned int SpikeStore::getDuration() const
+{
+	return isOpen() ? header_->duration : 0;
+}
+
+size_t SpikeStore::getNumberOfSpike() const
+{
+	return isOpen() ? header_->spikes : 0;
+}
+
+size_t SpikeStore::getNumberOfSpike(unsigned int neuron) const
+{
+	if(!isOpen() or neuron >= header_->neurons)
+	{
+		return 0;
+	}
+	return counts_[neuron];
+}
+
+vector<SpikeStore::Record> SpikeStore::getSpikes(unsigned int first, unsigned int last,
+												 unsigned int begin, unsigned int end) const
+{
+	vector<Record> spikes;
+
+	if(!isOpen())
+	{
+		return spikes;
+	}
+
+	last = min(last, header_->neurons);
+	end = min(end, header_->duration);
+	if(first >= last or begin >= end)
+	{
+		return spikes;
+	}
+
+	size_t b0 = begin/header_->block,
+		   b1 = (end-1)/header_->block + 1;
+
+	size_t nn = header_->neurons;
+
+	for (size_t b(b0); b<b1; ++b)
+	{
+		//the neurons first to last-1 are next to each other in the block
+		const Record* r = records_ + offsets_[b*nn + first];
+		const Record* hi = records_ + offsets_[b*nn + last];
+
+		for (; r != hi; ++r)
+		{
+			//only the first and the last blocks are partly outside
+			if(r->time >= begin and r->time < end)
+			{
+				spikes.push_back(*r);
+			}
+		}
+	}
+
+	return spikes;
+}
+
+vector< vector<double> > SpikeStore::getSpikeTrains(unsigned int first, unsigned int last,
+													unsigned int begin, unsigned int end) const
+{
+	vector<Record> spikes = getSpikes(first, last, begin, end);
+	vector< vector<double> > trains((last > first) ? last-first : 0);
+
+	//the blocks come in time order, so each train is sorted
+	for (size_t k(0); k<spikes.size(); ++k)
+	{
+		trains[spikes[k].neuron-first].push_back(spikes[k].time);
+	}
+
+	return trains;
+}
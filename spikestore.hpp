@@ -0,0 +1,186 @@
+#ifndef spikestore_HPP
+#define spikestore_HPP
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cstddef>
+
+using namespace std;
+
+/*!
+ * @brief spike store class
+ *
+ * this class writes the spikes of a simulation in an indexed binary file
+ * and reads them back by range of neurons and of time without scanning
+ * the whole file (the file is mapped in memory, only the pages of the
+ * blocks asked are read).
+ *
+ * the file is made of:
+ * 	- a header (see Header)
+ * 	- the number of spikes of each neuron (uint64, one per neuron)
+ * 	- the position of the first spike of each neuron in each time block
+ * 	  (uint64, block after block and neuron after neuron, plus the end of
+ * 	  the last block): the spikes of the neuron i in the block b are
+ * 	  between the positions b*neurons+i and b*neurons+i+1
+ * 	- the spikes (see Record), block after block, and inside a block
+ * 	  sorted by neuron and then by time
+ *
+ * the index takes 8 bytes per neuron and per block: with blocks of 1000
+ * steps (100ms), as much as one spike per neuron every 100ms.
+ *
+ * all the numbers are written in the byte order of the machine
+ */
+class SpikeStore
+{
+	public:
+
+		//!a spike of the file: its neuron and its time !in steps h!
+		struct Record
+		{
+			uint32_t neuron;
+			uint32_t time;
+		};
+
+	private:
+
+		//!beginning of a spike store file
+		struct Header
+		{
+			//!"SPKSTORE"
+			char magic[8];
+
+			//!version of the format
+			uint32_t version;
+
+			//!number of neurons and duration of the simulation !in steps h!
+			uint32_t neurons, duration;
+
+			//!duration of a time block !in steps h!
+			uint32_t block;
+
+			//!number of time blocks
+			uint32_t blocks;
+
+			//!total number of spikes
+			uint64_t spikes;
+		};
+
+		//!mapped file (null if the file could not be opened)
+		const char* data_;
+
+		//!size of the mapped file
+		size_t size_;
+
+		//!parts of the mapped file
+		const Header* header_;
+		const uint64_t* counts_;
+		const uint64_t* offsets_;
+		const Record* records_;
+
+		//!a store cannot be copied (it owns its mapping)
+		SpikeStore(const SpikeStore&) = delete;
+		SpikeStore& operator=(const SpikeStore&) = delete;
+
+	public:
+
+	//////////////////////////////
+	//                          //
+	// constructor & destructor //
+	//                          //
+	//////////////////////////////
+
+		/*!
+		 * @brief open and map a spike store file
+		 *
+		 * if the file cannot be read or is not a spike store an error is
+		 * displayed and isOpen returns false
+		 *
+		 * @param string file name of the file
+		 */
+		SpikeStore(const string& file);
+
+		/*!
+		 * @brief destructor, unmaps the file
+		 */
+		~SpikeStore();
+
+	//////////////////////////////
+	//                          //
+	//			Writer			//
+	//                          //
+	//////////////////////////////
+
+		/*!
+		 * @brief write the spikes of a simulation in a spike store file
+		 *
+		 * the spikes are copied in the file through a buffer of a fixed
+		 * size, only the index is built in memory
+		 *
+		 * @param string file name of the file
+		 * @param vector< vector<double> > spikes spike times of each neuron
+		 * 		  !in steps h! (sorted)
+		 * @param unsigned int duration duration of the simulation
+		 * @param unsigned int block duration of a time block of the index
+		 *
+		 * @return bool false if the file could not be written
+		 */
+		static bool write(const string& file, const vector< vector<double> >& spikes,
+						  unsigned int duration, unsigned int block = 1000);
+
+	//////////////////////////////
+	//                          //
+	//			Getters			//
+	//                          //
+	//////////////////////////////
+
+		/*!
+		 * @brief tells if the file is open
+		 */
+		bool isOpen() const;
+
+		/*!
+		 * @brief get the number of neurons of the simulation
+		 */
+		unsigned int getNumberOfNeurons() const;
+
+		/*!
+		 * @brief get the duration of the simulation !in steps h!
+		 */
+		unsigned int getDuration() const;
+
+		/*!
+		 * @brief get the total number of spikes
+		 */
+		size_t getNumberOfSpike() const;
+
+		/*!
+		 * @brief get the number of spikes of a neuron (read in the index)
+		 */
+		size_t getNumberOfSpike(unsigned int neuron) const;
+
+		/*!
+		 * @brief get the spikes of the neurons first to last-1 between the
+		 * 		  steps begin and end-1
+		 *
+		 * only the spikes of the neurons asked in the time blocks
+		 * overlapping [begin, end) are read, their position is read in
+		 * the index
+		 *
+		 * @return vector<Record> the spikes, block after block and inside
+		 * 		   a block sorted by neuron and time
+		 */
+		vector<Record> getSpikes(unsigned int first, unsigned int last,
+								 unsigned int begin, unsigned int end) const;
+
+		/*!
+		 * @brief same as getSpikes but grouped by neuron
+		 *
+		 * @return vector< vector<double> > spike times of the neurons
+		 * 		   first to last-1
+		 */
+		vector< vector<double> > getSpikeTrains(unsigned int first, unsigned int last,
+												unsigned int begin, unsigned int end) const;
+};
+
+#endif
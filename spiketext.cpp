@@ -0,0 +1,177 @@
+#include "spiketext.hpp"
+
+#include <cstdio>
+#include <cmath>
+#include <algorithm>
+
+using namespace std;
+
+/*
+ * writes the digits of an unsigned integer
+ */
+static char* formatInteger(unsigned int n, char* out)
+{
+	char digits[10];
+	int count(0);
+
+	do
+	{
+		digits[count++] = '0' + n%10;
+		n /= 10;
+	}while(n > 0);
+
+	while(count > 0)
+	{
+		*out++ = digits[--count];
+	}
+	return out;
+}
+
+char* formatSpikeTime(double t, char* out)
+{
+	if(t < 0 or t >= 1000000 or t != (unsigned int)(t))
+	{
+		int n = snprintf(out, spikeLineSize, "%g", t/100);
+		return out + n;
+	}
+
+	//integer part, then the two decimals without their trailing zeros
+	unsigned int k = t;
+	out = formatInteger(k/100, out);
+
+	unsigned int decimals = k%100;
+	if(decimals != 0)
+	{
+		*out++ = '.';
+		*out++ = '0' + decimals/10;
+		if(decimals%10 != 0)
+		{
+			*out++ = '0' + decimals%10;
+		}
+	}
+	return out;
+}
+
+char* formatSpikeLine(double t, unsigned int neuron, char* out)
+{
+	out = formatSpikeTime(t, out);
+	*out++ = '\t';
+	out = formatInteger(neuron, out);
+	*out++ = '\n';
+	return out;
+}
+
+bool readSpikeNumber(const char*& p, const char* end, double& value)
+{
+	bool negative(false),
+		 digits(false);
+	value = 0.0;
+
+	if(p < end and *p == '-')
+	{
+		negative = true;
+		++p;
+	}
+	while(p < end and *p >= '0' and *p <= '9')
+	{
+		value = value*10 + (*p-'0');
+		digits = true;
+		++p;
+	}
+	if(p < end and *p == '.')
+	{
+		++p;
+		double scale(0.1);
+		while(p < end and *p >= '0' and *p <= '9')
+		{
+			value += (*p-'0')*scale;
+			scale /= 10;
+			digits = true;
+			++p;
+		}
+	}
+	if(digits and p < end and (*p == 'e' or *p == 'E'))
+	{
+		++p;
+		int sign(1),
+			exponent(0);
+		if(p < end and (*p == '+' or *p == '-'))
+		{
+			sign = (*p == '-') ? -1 : 1;
+			++p;
+		}
+		while(p < end and *p >= '0' and *p <= '9')
+		{
+			exponent = exponent*10 + (*p-'0');
+			++p;
+		}
+		value *= pow(10.0, sign*exponent);
+	}
+
+	if(negative)
+	{
+		value = -value;
+	}
+	return digits;
+}
+
+void parseSpikeText(const char* begin, const char* end, vector<SpikeLine>& spikes)
+{
+	const char* p = begin;
+
+	while(p < end)
+	{
+		if(*p == '\n' or *p == '\r')
+		{
+			++p;
+			continue;
+		}
+
+		SpikeLine s;
+		double time(0.0),
+			   neuron(0.0);
+		bool valid = readSpikeNumber(p, end, time);
+
+		while(p < end and (*p == '\t' or *p == ' '))
+		{
+			++p;
+		}
+		valid = readSpikeNumber(p, end, neuron) and valid;
+
+		//the rest of the line is skipped
+		while(p < end and *p != '\n')
+		{
+			++p;
+		}
+		++p;
+
+		/*
+		 * printSpikeTimes writes the times in steps/100, they are put
+		 * back in steps
+		 */
+		s.time = floor(time*100 + 0.5);
+		s.neuron = neuron;
+
+		if(valid and s.neuron >= 0)
+		{
+			spikes.push_back(s);
+		}
+	}
+}
+
+vector<const char*> cutSpikeText(const char* data, size_t size, size_t parts)
+{
+	//each cut is moved to the beginning of the next line
+	vector<const char*> cuts(parts+1, data+size);
+	cuts[0] = data;
+	for (size_t w(1); w<parts; ++w)
+	{
+		const char* p = max(data + w*(size/parts), cuts[w-1]);
+		while(p < data+size and p > data and *(p-1) != '\n')
+		{
+			++p;
+		}
+		cuts[w] = p;
+	}
+	return cuts;
+}
@@ -0,0 +1,86 @@
+#ifndef spiketext_HPP
+#define spiketext_HPP
+
+#include <cstddef>
+#include <vector>
+
+using namespace std;
+
+/*
+ * text formatting of the spikes
+ *
+ * those functions write the lines of data_neuro.txt ("time	neuron", the
+ * time in steps/100) directly in a buffer, character for character as an
+ * ostream with its default format would, but without its locale and
+ * stream machinery. They are used to export the spikes of many neurons
+ * in parallel (see NetworkT::printSpikeTimes), and to read them back in
+ * parallel (see analysis.cpp)
+ */
+
+//!maximal number of characters written by formatSpikeLine
+static const size_t spikeLineSize(64);
+
+/*!
+ * @brief write the time of a spike t/100 like an ostream (%g, 6 digits)
+ *
+ * @param double t time of the spike !in steps h!
+ * @param char* out where the characters are written
+ *
+ * @return char* the end of the characters written
+ *
+ * the integer times under 10^6 steps are written digit by digit (they
+ * have at most 6 significant digits, so their text is exact), the others
+ * go through snprintf
+ */
+char* formatSpikeTime(double t, char* out);
+
+/*!
+ * @brief write the line "t/100	neuron\n" of a spike
+ *
+ * @return char* the end of the line (at most spikeLineSize characters)
+ */
+char* formatSpikeLine(double t, unsigned int neuron, char* out);
+
+/*!
+ * @brief spike read in a text
+ */
+struct SpikeLine
+{
+	int neuron;
+
+	//!time of the spike !in steps h!
+	double time;
+};
+
+/*!
+ * @brief read a number written by an ostream (digits, decimals, exponent)
+ *
+ * @param const char*& p start of the number, moved after it
+ * @param const char* end end of the text
+ * @param double& value the number read
+ *
+ * @return bool false if there is no digit at p
+ */
+bool readSpikeNumber(const char*& p, const char* end, double& value);
+
+/*!
+ * @brief read the lines "t/100	neuron" between begin and end
+ *
+ * the lines that do not start with two numbers, and the negative neurons,
+ * are skipped
+ *
+ * @param vector<SpikeLine> spikes where the spikes are added
+ */
+void parseSpikeText(const char* begin, const char* end, vector<SpikeLine>& spikes);
+
+/*!
+ * @brief cut a text in parts made of whole lines, to parse them in parallel
+ *
+ * @param size_t parts number of parts
+ *
+ * @return vector<const char*> the parts+1 bounds of the parts (a part can
+ * 		   be empty)
+ */
+vector<const char*> cutSpikeText(const char* data, size_t size, size_t parts);
+
+#endif
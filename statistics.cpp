@@ -0,0 +1,406 @@
+#include "statistics.hpp"
+
+#include <cmath>
+#include <random>
+#include <thread>
+#include <algorithm>
+
+using namespace std;
+
+	//////////////////////////////
+	//                          //
+	//		  constructor		//
+	//                          //
+	//////////////////////////////
+
+Statistics::Statistics(const vector< vector<double> >& spikes, unsigned int t_stop,
+					   unsigned int workers)
+		:spikes_(spikes),
+		 t_stop_(t_stop),
+		 workers_(workers > 0 ? workers : 1)
+{}
+
+void Statistics::parallel(size_t n, const function<void(size_t, size_t, size_t)>& f) const
+{
+	size_t workers = min(size_t(workers_), max(n, size_t(1)));
+	size_t size = (n+workers-1)/workers;
+
+	vector<thread> threads;
+	for (size_t w(1); w<workers; ++w)
+	{
+		threads.push_back(thread(f, min(w*size, n), min((w+1)*size, n), w));
+	}
+	f(0, min(size, n), 0);
+
+	for (size_t w(0); w<threads.size(); ++w)
+	{
+		threads[w].join();
+	}
+}
+
+	//////////////////////////////
+	//                          //
+	//			Getters			//
+	//                          //
+	//////////////////////////////
+
+size_t Statistics::getNumberOfSpike() const
+{
+	size_t total(0);
+	for (size_t i(0); i<spikes_.size(); ++i)
+	{
+		total += spikes_[i].size();
+	}
+	return total;
+}
+
+double Statistics::getMeanRate() const
+{
+	if(spikes_.empty() or t_stop_ == 0)
+	{
+		return 0.0;
+	}
+
+	//duration of the simulation in seconds
+	double T = t_stop_*h_ms/1000;
+
+	return getNumberOfSpike()/(spikes_.size()*T);
+}
+
+vector<double> Statistics::getCV() const
+{
+	//each worker computes the CV of a range of neurons
+	vector< vector<double> > parts(workers_);
+
+	parallel(spikes_.size(), [&](size_t begin, size_t end, size_t w)
+	{
+		for (size_t i(begin); i<end; ++i)
+		{
+			const vector<double>& s = spikes_[i];
+
+			if(s.size() < 3)
+			{
+				continue;
+			}
+
+			double mean(0.0),
+				   var(0.0);
+			size_t n = s.size()-1;
+
+			for (size_t j(1); j<s.size(); ++j)
+			{
+				mean += s[j]-s[j-1];
+			}
+			mean /= n;
+
+			for (size_t j(1); j<s.size(); ++j)
+			{
+				double d = s[j]-s[j-1]-mean;
+				var += d*d;
+			}
+			var /= n;
+
+			parts[w].push_back(sqrt(var)/mean);
+		}
+	});
+
+	vector<double> cv;
+	for (size_t w(0); w<parts.size(); ++w)
+	{
+		cv.insert(cv.end(), parts[w].begin(), parts[w].end());
+	}
+	return cv;
+}
+
+double Statistics::getMeanCV() const
+{
+	vector<double> cv = getCV();
+
+	if(cv.empty())
+	{
+		return 0.0;
+	}
+
+	double mean(0.0);
+	for (size_t i(0); i<cv.size(); ++i)
+	{
+		mean += cv[i];
+	}
+	return mean/cv.size();
+}
+
+vector<double> Statistics::getPopulationRate(unsigned int bin) const
+{
+	vector<double> rate((t_stop_+bin-1)/bin, 0.0);
+
+	for (size_t i(0); i<spikes_.size(); ++i)
+	{
+		for (size_t j(0); j<spikes_[i].size(); ++j)
+		{
+			size_t k = spikes_[i][j]/bin;
+			if(k < rate.size())
+			{
+				++rate[k];
+			}
+		}
+	}
+
+	return rate;
+}
+
+vector<double> Statistics::getPowerSpectrum(unsigned int bin) const
+{
+	vector<double> rate = getPopulationRate(bin);
+
+	size_t n(1);
+	while(n < rate.size())
+	{
+		n *= 2;
+	}
+
+	double mean(0.0);
+	for (size_t i(0); i<rate.size(); ++i)
+	{
+		mean += rate[i];
+	}
+	if(!rate.empty())
+	{
+		mean /= rate.size();
+	}
+
+	vector< complex<double> > x(n, 0.0);
+	for (size_t i(0); i<rate.size(); ++i)
+	{
+		x[i] = rate[i]-mean;
+	}
+
+	fft(x);
+
+	vector<double> power(n/2+1);
+	for (size_t k(0); k<power.size(); ++k)
+	{
+		power[k] = norm(x[k])/n;
+	}
+
+	return power;
+}
+
+double Statistics::getFrequencyResolution(unsigned int bin) const
+{
+	size_t bins = (t_stop_+bin-1)/bin;
+
+	size_t n(1);
+	while(n < bins)
+	{
+		n *= 2;
+	}
+
+	return 1000.0/(n*bin*h_ms);
+}
+
+vector<double> Statistics::getNeuronRate(size_t neuron, unsigned int bin) const
+{
+	vector<double> rate((t_stop_+bin-1)/bin, 0.0);
+
+	for (size_t j(0); j<spikes_[neuron].size(); ++j)
+	{
+		size_t k = spikes_[neuron][j]/bin;
+		if(k < rate.size())
+		{
+			++rate[k];
+		}
+	}
+	return rate;
+}
+
+double Statistics::getSynchrony(unsigned int bin) const
+{
+	size_t bins = (t_stop_+bin-1)/bin;
+
+	if(spikes_.empty() or bins == 0)
+	{
+		return 0.0;
+	}
+
+	/*
+	 * the variance of each neuron only needs its spikes: with c_k spikes
+	 * in the bin k, var = sum(c_k^2)/bins - (sum(c_k)/bins)^2
+	 */
+	vector<double> parts(workers_, 0.0);
+
+	parallel(spikes_.size(), [&](size_t begin, size_t end, size_t w)
+	{
+		for (size_t i(begin); i<end; ++i)
+		{
+			const vector<double>& s = spikes_[i];
+			double sum(0.0),
+				   squares(0.0),
+				   c(0.0);
+			long last(-1);
+
+			for (size_t j(0); j<=s.size(); ++j)
+			{
+				long k = (j < s.size()) ? long(s[j]/bin) : -2;
+				if(k != last)
+				{
+					sum += c;
+					squares += c*c;
+					c = 0.0;
+					last = k;
+				}
+				++c;
+			}
+
+			double mean = sum/bins;
+			parts[w] += squares/bins - mean*mean;
+		}
+	});
+
+	double neuronVar(0.0);
+	for (size_t w(0); w<parts.size(); ++w)
+	{
+		neuronVar += parts[w];
+	}
+	neuronVar /= spikes_.size();
+
+	vector<double> rate = getPopulationRate(bin);
+	double mean(0.0),
+		   var(0.0);
+	for (size_t k(0); k<rate.size(); ++k)
+	{
+		mean += rate[k];
+	}
+	mean /= rate.size();
+	for (size_t k(0); k<rate.size(); ++k)
+	{
+		var += (rate[k]-mean)*(rate[k]-mean);
+	}
+
+	//variance of the population rate averaged over the neurons
+	var /= rate.size()*double(spikes_.size())*spikes_.size();
+
+	if(neuronVar <= 0)
+	{
+		return 0.0;
+	}
+	return sqrt(var/neuronVar);
+}
+
+vector<double> Statistics::getCrossCorrelation(size_t pairs, unsigned int bin,
+											   unsigned int seed, int lag) const
+{
+	//bins of the first neuron having a bin lag bins later
+	long bins = (t_stop_+bin-1)/bin;
+	long first = max(0L, -long(lag)),
+		 last = min(bins, bins-lag);
+
+	if(spikes_.size() < 2 or first >= last)
+	{
+		return vector<double>();
+	}
+
+	//the pairs are drawn before so that they do not depend on the workers
+	mt19937 gen(seed);
+	uniform_int_distribution<size_t> dis(0, spikes_.size()-1);
+	vector< pair<size_t, size_t> > chosen;
+	while(chosen.size() < pairs)
+	{
+		size_t a = dis(gen),
+			   b = dis(gen);
+		if(a != b)
+		{
+			chosen.push_back(make_pair(a, b));
+		}
+	}
+
+	vector<double> coefficients(pairs, 0.0);
+	vector<char> valid(pairs, 0);
+
+	parallel(pairs, [&](size_t begin, size_t end, size_t)
+	{
+		for (size_t p(begin); p<end; ++p)
+		{
+			vector<double> x = getNeuronRate(chosen[p].first, bin),
+						   y = getNeuronRate(chosen[p].second, bin);
+			double mx(0.0), my(0.0);
+			for (long k(first); k<last; ++k)
+			{
+				mx += x[k];
+				my += y[k+lag];
+			}
+			mx /= last-first;
+			my /= last-first;
+
+			double sxy(0.0), sxx(0.0), syy(0.0);
+			for (long k(first); k<last; ++k)
+			{
+				sxy += (x[k]-mx)*(y[k+lag]-my);
+				sxx += (x[k]-mx)*(x[k]-mx);
+				syy += (y[k+lag]-my)*(y[k+lag]-my);
+			}
+
+			if(sxx > 0 and syy > 0)
+			{
+				coefficients[p] = sxy/sqrt(sxx*syy);
+				valid[p] = 1;
+			}
+		}
+	});
+
+	vector<double> result;
+	for (size_t p(0); p<pairs; ++p)
+	{
+		if(valid[p])
+		{
+			result.push_back(coefficients[p]);
+		}
+	}
+	return result;
+}
+
+	//////////////////////////////
+	//                          //
+	//		  Transform			//
+	//                          //
+	//////////////////////////////
+
+void Statistics::fft(vector< complex<double> >& x)
+{
+	size_t n = x.size();
+
+	//bit reversal permutation
+	for (size_t i(1), j(0); i<n; ++i)
+	{
+		size_t bit = n >> 1;
+		for (; j & bit; bit >>= 1)
+		{
+			j ^= bit;
+		}
+		j ^= bit;
+
+		if(i < j)
+		{
+			swap(x[i], x[j]);
+		}
+	}
+
+	//butterflies
+	for (size_t len(2); len<=n; len <<= 1)
+	{
+		double angle = -2*acos(-1.0)/len;
+		complex<double> wlen(cos(angle), sin(angle));
+
+		for (size_t i(0); i<n; i += len)
+		{
+			complex<double> w(1.0);
+			for (size_t j(0); j<len/2; ++j)
+			{
+				complex<double> u = x[i+j];
+				complex<double> v = x[i+j+len/2]*w;
+				x[i+j] = u+v;
+				x[i+j+len/2] = u-v;
+				w *= wlen;
+			}
+		}
+	}
+}
@@ -0,0 +1,161 @@
+#ifndef statistics_HPP
+#define statistics_HPP
+
+#include "constant.hpp"
+
+#include <vector>
+#include <complex>
+#include <functional>
+
+using namespace std;
+
+/*!
+ * @brief statistics class
+ *
+ * this class computes the population statistics of a simulation from the
+ * spike times of each neuron: mean firing rate, coefficient of variation
+ * of the inter-spike intervals and spectrum of the population rate.
+ * They are used to compare two simulations that are not expected to
+ * produce exactly the same spikes, and to classify a simulation in one of
+ * the regimes described by Brunel
+ *
+ * the computations made neuron by neuron (or pair by pair) are shared
+ * between several threads
+ */
+class Statistics
+{
+	private:
+
+		//!spike times of each neuron !in steps h!
+		vector< vector<double> > spikes_;
+
+		//!duration of the simulation !in steps h!
+		unsigned int t_stop_;
+
+		//!number of threads used for the computations
+		unsigned int workers_;
+
+		/*!
+		 * @brief split the indices 0 to n-1 in contiguous ranges and call
+		 * 		  f(begin, end, worker) for each range in its own thread
+		 */
+		void parallel(size_t n, const function<void(size_t, size_t, size_t)>& f) const;
+
+		/*!
+		 * @brief get the number of spikes of a neuron in each bin
+		 */
+		vector<double> getNeuronRate(size_t neuron, unsigned int bin) const;
+
+		/*!
+		 * @brief in place radix-2 fast fourier transform
+		 *
+		 * @param vector< complex<double> > x the signal, its size has to
+		 * 		  be a power of 2
+		 */
+		static void fft(vector< complex<double> >& x);
+
+	public:
+
+	//////////////////////////////
+	//                          //
+	//		  constructor		//
+	//                          //
+	//////////////////////////////
+
+		/*!
+		 * @brief initialise the statistics of a simulation
+		 *
+		 * @param vector< vector<double> > spikes spike times of each neuron
+		 * @param unsigned int t_stop duration of the simulation
+		 * @param unsigned int workers number of threads used
+		 */
+		Statistics(const vector< vector<double> >& spikes, unsigned int t_stop,
+				   unsigned int workers = 1);
+
+	//////////////////////////////
+	//                          //
+	//			Getters			//
+	//                          //
+	//////////////////////////////
+
+		/*!
+		 * @brief get the total number of spikes of the simulation
+		 */
+		size_t getNumberOfSpike() const;
+
+		/*!
+		 * @brief get the mean firing rate of a neuron [Hz]
+		 */
+		double getMeanRate() const;
+
+		/*!
+		 * @brief get the coefficient of variation of the inter-spike
+		 * 		  intervals of each neuron having at least 3 spikes
+		 *
+		 * @return vector<double> the CV of those neurons
+		 */
+		vector<double> getCV() const;
+
+		/*!
+		 * @brief get the mean of the CV returned by getCV (0 if none)
+		 */
+		double getMeanCV() const;
+
+		/*!
+		 * @brief get the number of spikes of the whole population in
+		 * 		  consecutive bins
+		 *
+		 * @param unsigned int bin width of a bin !in steps h!
+		 *
+		 * @return vector<double> number of spikes in each bin
+		 */
+		vector<double> getPopulationRate(unsigned int bin) const;
+
+		/*!
+		 * @brief get the power spectrum of the population rate (mean
+		 * 		  removed, zero padded to a power of 2)
+		 *
+		 * @param unsigned int bin width of a bin of the population rate
+		 *
+		 * @return vector<double> power at the frequencies k*df, from 0 to
+		 * 		   the Nyquist frequency (see getFrequencyResolution)
+		 */
+		vector<double> getPowerSpectrum(unsigned int bin) const;
+
+		/*!
+		 * @brief get the frequency step df of getPowerSpectrum [Hz]
+		 *
+		 * @param unsigned int bin width of a bin of the population rate
+		 */
+		double getFrequencyResolution(unsigned int bin) const;
+
+		/*!
+		 * @brief get the synchrony index chi of the population (Golomb):
+		 * 		  square root of the variance of the population rate over
+		 * 		  the mean variance of the rates of the neurons
+		 *
+		 * it is close to 1/sqrt(N) for independent neurons and to 1 for
+		 * fully synchronous ones
+		 *
+		 * @param unsigned int bin width of a bin of the rates
+		 */
+		double getSynchrony(unsigned int bin) const;
+
+		/*!
+		 * @brief get the correlation coefficients of the binned spike counts
+		 * 		  of random pairs of neurons
+		 *
+		 * @param size_t pairs number of pairs sampled
+		 * @param unsigned int bin width of a bin of the rates
+		 * @param unsigned int seed seed used to choose the pairs
+		 * @param int lag the counts of the first neuron of a pair are
+		 * 		  compared with the ones of the second lag bins later
+		 *
+		 * @return vector<double> the coefficient of each pair (pairs with a
+		 * 		   silent neuron are skipped)
+		 */
+		vector<double> getCrossCorrelation(size_t pairs, unsigned int bin,
+										   unsigned int seed = 1, int lag = 0) const;
+};
+
+#endif
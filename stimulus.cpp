@@ -0,0 +1,101 @@
+#include "stimulus.hpp"
+#include "constant.hpp"
+
+#include <cmath>
+
+using namespace std;
+
+	//////////////////////////////
+	//                          //
+	//		  constructors		//
+	//                          //
+	//////////////////////////////
+
+Stimulus::Stimulus(stimulus_type type, unsigned int start, unsigned int stop)
+		:type_(type),
+		 start_(start),
+		 stop_(stop),
+		 amplitude_(0.0),
+		 offset_(0.0),
+		 frequency_(0.0),
+		 phase_(0.0),
+		 interval_(1)
+{}
+
+Stimulus Stimulus::step(double amplitude, unsigned int start, unsigned int stop)
+{
+	Stimulus s(STEP, start, stop);
+	s.amplitude_ = amplitude;
+	return s;
+}
+
+Stimulus Stimulus::ramp(double from, double to, unsigned int start, unsigned int stop)
+{
+	Stimulus s(RAMP, start, stop);
+	s.amplitude_ = from;
+	s.offset_ = to;
+	return s;
+}
+
+Stimulus Stimulus::sine(double amplitude, double frequency, double phase,
+						unsigned int start, unsigned int stop, double offset)
+{
+	Stimulus s(SINE, start, stop);
+	s.amplitude_ = amplitude;
+	s.frequency_ = frequency;
+	s.phase_ = phase;
+	s.offset_ = offset;
+	return s;
+}
+
+Stimulus Stimulus::waveform(const vector<double>& samples, unsigned int start,
+							unsigned int interval)
+{
+	if(interval == 0)
+	{
+		interval = 1;
+	}
+
+	Stimulus s(WAVEFORM, start, start + samples.size()*interval);
+	s.samples_ = samples;
+	s.interval_ = interval;
+	return s;
+}
+
+	//////////////////////////////
+	//                          //
+	//			Getters			//
+	//                          //
+	//////////////////////////////
+
+bool Stimulus::isActive(unsigned int t) const
+{
+	return t >= start_ and t < stop_;
+}
+
+double Stimulus::getCurrent(unsigned int t) const
+{
+	if(!isActive(t))
+	{
+		return 0.0;
+	}
+
+	unsigned int dt = t - start_;
+
+	switch(type_)
+	{
+		case STEP:
+			return amplitude_;
+
+		case RAMP:
+			return amplitude_ + (offset_-amplitude_)*dt/(stop_-start_);
+
+		case SINE:
+			return offset_ + amplitude_*sin(2*acos(-1.0)*frequency_*dt*h_ms/1000 + phase_);
+
+		case WAVEFORM:
+			return samples_[dt/interval_];
+	}
+
+	return 0.0;
+}
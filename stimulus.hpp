@@ -0,0 +1,100 @@
+#ifndef stimulus_HPP
+#define stimulus_HPP
+
+#include <vector>
+
+using namespace std;
+
+//tells the shape of an external current
+enum stimulus_type{STEP, RAMP, SINE, WAVEFORM};
+
+/*!
+ * @brief stimulus class
+ *
+ * this class describes an external electric current varying in time: a
+ * step, a ramp, a sinusoid or a recorded waveform. The network evaluates
+ * it once per step and injects the value in a whole group of neurons
+ */
+class Stimulus
+{
+	private:
+
+		//!shape of the current
+		stimulus_type type_;
+
+		//!first step and last step+1 during which the current is applied
+		unsigned int start_, stop_;
+
+		//!amplitude of a step or a sinusoid, start value of a ramp
+		double amplitude_;
+
+		//!end value of a ramp, offset of a sinusoid
+		double offset_;
+
+		//!frequency of a sinusoid [Hz]
+		double frequency_;
+
+		//!phase of a sinusoid [rad]
+		double phase_;
+
+		//!recorded values of a waveform
+		vector<double> samples_;
+
+		//!number of steps between two samples of a waveform
+		unsigned int interval_;
+
+		Stimulus(stimulus_type type, unsigned int start, unsigned int stop);
+
+	public:
+
+	//////////////////////////////
+	//                          //
+	//		  constructors		//
+	//                          //
+	//////////////////////////////
+
+		/*!
+		 * @brief constant current applied from start to stop-1
+		 */
+		static Stimulus step(double amplitude, unsigned int start, unsigned int stop);
+
+		/*!
+		 * @brief current going linearly from the value from at start to
+		 * 		  the value to at stop
+		 */
+		static Stimulus ramp(double from, double to, unsigned int start, unsigned int stop);
+
+		/*!
+		 * @brief current offset + amplitude*sin(2*pi*frequency*t + phase),
+		 * 		  t being the time elapsed since start
+		 *
+		 * @param double frequency frequency [Hz]
+		 */
+		static Stimulus sine(double amplitude, double frequency, double phase,
+							 unsigned int start, unsigned int stop, double offset = 0.0);
+
+		/*!
+		 * @brief recorded current, a sample every interval steps from start
+		 * 		  (the current is null once all the samples are used)
+		 */
+		static Stimulus waveform(const vector<double>& samples, unsigned int start,
+								 unsigned int interval = 1);
+
+	//////////////////////////////
+	//                          //
+	//			Getters			//
+	//                          //
+	//////////////////////////////
+
+		/*!
+		 * @brief tells if the current is applied at step t
+		 */
+		bool isActive(unsigned int t) const;
+
+		/*!
+		 * @brief get the value of the current at step t
+		 */
+		double getCurrent(unsigned int t) const;
+};
+
+#endif
@@ -1,10 +1,28 @@
 #include "gtest/gtest.h"
 #include "neuron.hpp"
 #include "network.hpp"
+#include "statistics.hpp"
+#include "arena.hpp"
+#include "stimulus.hpp"
+#include "runcontroller.hpp"
+#include "fixednetwork.hpp"
+#include "spikestore.hpp"
+#include "progress.hpp"
+#include "spiketext.hpp"
+#include "eventstream.hpp"
+#include "areanetwork.hpp"
+#include "noisetape.hpp"
+#include "wiring.hpp"
 
 #include <iostream>
 #include <vector>
 #include <cmath>
+#include <cstdio>
+#include <sstream>
+#include <algorithm>
+#include <random>
+#include <thread>
+#include <memory>
 
 using namespace std;
 
@@ -194,3 +212,1218 @@ int main(int argc, char **argv)
 		}
 	}
 
+	/*
+	 * test if two networks built with the same seed are identical and
+	 * stay identical during a simulation
+	 */
+	TEST (NetworkTest, seedReproducibility)
+	{
+		Network a(42),
+				b(42);
+		
+		EXPECT_EQ(a.getConnectionMap(), b.getConnectionMap());
+		
+		a.runSimulation(100);
+		b.runSimulation(100);
+		
+		EXPECT_EQ(a.getSpikeTrains(), b.getSpikeTrains());
+	}
+
+	/*
+	 * test if a connection set manually is added to the right row
+	 * without changing the others
+	 */
+	TEST (NetworkTest, manualConnection)
+	{
+		Network net(7);
+		
+		vector< vector<int> > before = net.getConnectionMap();
+		net.setManualConnection(3, 4);
+		vector< vector<int> > after = net.getConnectionMap();
+		
+		before[3].push_back(4);
+		EXPECT_EQ(before, after);
+	}
+
+	/*
+	 * test if batches of added, removed and moved connections give the
+	 * same rows (in any order) as the same edits on a plain map, before
+	 * and after the compaction
+	 */
+	TEST (NetworkTest, rewiring)
+	{
+		Network net(23);
+		vector< vector<int> > map = net.getConnectionMap();
+		
+		mt19937 gen(1);
+		uniform_int_distribution<> dis(0, N-1);
+		
+		for (int round(0); round<20; ++round)
+		{
+			vector<Synapse> added, removed;
+			vector<Rewiring> moved;
+			
+			for (int k(0); k<10; ++k)
+			{
+				Synapse s = {unsigned(dis(gen)), unsigned(dis(gen))};
+				added.push_back(s);
+				map[s.pre].push_back(s.post);
+			}
+			for (int k(0); k<10; ++k)
+			{
+				unsigned int pre = dis(gen);
+				if(!map[pre].empty())
+				{
+					Synapse s = {pre, unsigned(map[pre][0])};
+					removed.push_back(s);
+					map[pre].erase(map[pre].begin());
+				}
+			}
+			for (int k(0); k<10; ++k)
+			{
+				unsigned int pre = dis(gen);
+				if(!map[pre].empty())
+				{
+					Rewiring r = {pre, unsigned(map[pre].back()), unsigned(dis(gen))};
+					moved.push_back(r);
+					map[pre].back() = r.to;
+				}
+			}
+			
+			EXPECT_EQ(net.addConnections(added), added.size());
+			EXPECT_EQ(net.removeConnections(removed), removed.size());
+			EXPECT_EQ(net.rewireConnections(moved), moved.size());
+		}
+		
+		size_t total(0);
+		for (int i(0); i<N; ++i)
+		{
+			sort(map[i].begin(), map[i].end());
+			total += map[i].size();
+		}
+		
+		for (int pass(0); pass<2; ++pass)
+		{
+			vector< vector<int> > rows = net.getConnectionMap();
+			for (int i(0); i<N; ++i)
+			{
+				sort(rows[i].begin(), rows[i].end());
+			}
+			EXPECT_EQ(rows, map);
+			EXPECT_EQ(net.getNumberOfConnections(), total);
+			
+			net.compactConnections();
+		}
+		
+		net.runSimulation(100);
+	}
+
+	/*
+	 * test the pull delivery: with one worker it fires like the push mode;
+	 * with several workers and the noise of one worker (replayed) it gives
+	 * the same spikes, step by step, on the same map
+	 */
+	TEST (NetworkTest, pullDelivery)
+	{
+		Network push(47), single(47), parallel(47);
+		push.addStimulus(Stimulus::step(1.01, 0, 1000), 0, N);
+		single.addStimulus(Stimulus::step(1.01, 0, 1000), 0, N);
+		parallel.addStimulus(Stimulus::step(1.01, 0, 1000), 0, N);
+		
+		single.setDeliveryMode(PULL, 1);
+		parallel.setDeliveryMode(PULL, 4);
+		
+		push.runSimulation(1000);
+		ASSERT_TRUE(single.recordNoise("test_pull.tape"));
+		single.runSimulation(1000);
+		single.stopNoise();
+		
+		double ratio = double(single.getNumberOfSpike())/push.getNumberOfSpike();
+		EXPECT_GT(ratio, 0.9);
+		EXPECT_LT(ratio, 1.1);
+		
+		SpikeStream stream;
+		parallel.setSpikeStream(&stream);
+		ASSERT_TRUE(parallel.replayNoise("test_pull.tape"));
+		
+		vector<size_t> perStep(1000, 0);
+		unsigned int steps(0);
+		for (int k(0); k<10; ++k)
+		{
+			parallel.step(100);
+			
+			const SpikeEvent* events;
+			size_t n;
+			while((n = stream.read(events)) > 0)
+			{
+				for (size_t e(0); e<n; ++e)
+				{
+					EXPECT_EQ(events[e].time, steps);
+					if(events[e].neuron == endOfStep)
+					{
+						++steps;
+					}
+					else
+					{
+						++perStep[events[e].time];
+					}
+				}
+				stream.release(n);
+			}
+		}
+		remove("test_pull.tape");
+		
+		EXPECT_EQ(steps, 1000);
+		EXPECT_EQ(parallel.getSpikeTrains(), single.getSpikeTrains());
+		EXPECT_EQ(parallel.getConnectionMap(), push.getConnectionMap());
+		
+		//the spikes of each step are all counted once
+		size_t total(0);
+		for (size_t t(0); t<perStep.size(); ++t)
+		{
+			total += perStep[t];
+		}
+		EXPECT_EQ(total, single.getNumberOfSpike());
+		EXPECT_EQ(parallel.getStatus().spikes, total);
+		
+		//the parked workers are stopped and started again with new blocks
+		parallel.setSpikeStream(nullptr);
+		parallel.setDeliveryMode(PULL, 2);
+		parallel.step(10);
+		parallel.setDeliveryMode(PUSH);
+		parallel.step(10);
+		EXPECT_EQ(parallel.getClock(), 1020);
+		
+		//a rewiring that changes nothing keeps the noise of the blocks
+		Network plain(53), rewired(53);
+		plain.setDeliveryMode(PULL, 4);
+		rewired.setDeliveryMode(PULL, 4);
+		plain.addStimulus(Stimulus::step(1.01, 0, 1000), 0, N);
+		rewired.addStimulus(Stimulus::step(1.01, 0, 1000), 0, N);
+		
+		plain.runSimulation(1000);
+		rewired.runSimulation(500);
+		rewired.rewireConnections(vector<Rewiring>());
+		rewired.runSimulation(1000);
+		EXPECT_EQ(rewired.getSpikeTrains(), plain.getSpikeTrains());
+	}
+
+	/*
+	 * test if the batched delivery gives the spikes of the pull delivery
+	 * with one worker: both draw the noise neuron after neuron and deliver
+	 * the spikes of a step once every neuron is updated
+	 */
+	TEST (NetworkTest, batchedDelivery)
+	{
+		Network pull(61),
+				batched(61);
+		pull.setDeliveryMode(PULL, 1);
+		batched.setDeliveryMode(BATCHED);
+		
+		pull.addStimulus(Stimulus::step(1.01, 0, 2000), 0, N);
+		batched.addStimulus(Stimulus::step(1.01, 0, 2000), 0, N);
+		
+		pull.runSimulation(2000);
+		batched.runSimulation(2000);
+		
+		EXPECT_GT(pull.getNumberOfSpike(), 0);
+		EXPECT_EQ(batched.getNumberOfSpike(), pull.getNumberOfSpike());
+		EXPECT_EQ(batched.getSpikeTrains(), pull.getSpikeTrains());
+	}
+
+	/*
+	 * test if the memory of the network stays bounded when its map is
+	 * laid out again many times, in push and in pull mode
+	 */
+	TEST (NetworkTest, rewiringMemory)
+	{
+		delivery_mode modes[] = {PUSH, PULL};
+		
+		for (int m(0); m<2; ++m)
+		{
+			Network net(23);
+			net.setDeliveryMode(modes[m], 4);
+			
+			//more connections than the free places of the row: the map
+			//is laid out again at each round
+			vector<Synapse> synapses(max(Ctot/32, 4) + 1, Synapse{0, 1});
+			size_t first(0);
+			
+			for (int round(0); round<10; ++round)
+			{
+				EXPECT_EQ(net.addConnections(synapses), synapses.size());
+				EXPECT_EQ(net.removeConnections(synapses), synapses.size());
+				net.compactConnections();
+				
+				if(round == 0)
+				{
+					first = net.getFootprint();
+				}
+			}
+			
+			EXPECT_LE(net.getFootprint(), first + first/8);
+			net.runSimulation(10);
+		}
+	}
+
+	/*
+	 * test if the spikes streamed step after step are the ones of the
+	 * network in every delivery mode, and if the input commands act like
+	 * the same stimulus, also when each step waits for its controller
+	 */
+	TEST (NetworkTest, closedLoop)
+	{
+		delivery_mode modes[] = {PUSH, PULL, BATCHED};
+		
+		for (int m(0); m<3; ++m)
+		{
+			Network net(29);
+			net.setDeliveryMode(modes[m], 2);
+			
+			SpikeStream stream;
+			net.setSpikeStream(&stream);
+			
+			vector<size_t> counts(N, 0);
+			unsigned int steps(0);
+			
+			for (int k(0); k<50; ++k)
+			{
+				net.step(20);
+				
+				const SpikeEvent* events;
+				size_t n;
+				while((n = stream.read(events)) > 0)
+				{
+					for (size_t e(0); e<n; ++e)
+					{
+						EXPECT_EQ(events[e].time, steps);
+						if(events[e].neuron == endOfStep)
+						{
+							++steps;
+						}
+						else
+						{
+							++counts[events[e].neuron];
+						}
+					}
+					stream.release(n);
+				}
+			}
+			
+			EXPECT_EQ(steps, 1000);
+			EXPECT_EQ(stream.getDropped(), 0);
+			
+			vector<Neuron> list = net.getNeurons();
+			for (int i(0); i<N; ++i)
+			{
+				EXPECT_EQ(counts[i], list[i].getNumberOfSpike());
+			}
+		}
+		
+		//commands sent beforehand
+		Network stimulated(31), driven(31);
+		stimulated.addStimulus(Stimulus::step(1.01, 100, 300), 0, 10);
+		
+		InputStream input;
+		driven.setInputStream(&input);
+		for (uint32_t i(0); i<10; ++i)
+		{
+			input.write(InputCommand{100, i, 1.01});
+		}
+		for (uint32_t i(0); i<10; ++i)
+		{
+			input.write(InputCommand{300, i, 0.0});
+		}
+		input.publish();
+		
+		stimulated.runSimulation(500);
+		for (int k(0); k<500; ++k)
+		{
+			driven.step();
+		}
+		EXPECT_EQ(driven.getSpikeTrains(), stimulated.getSpikeTrains());
+		
+		//more commands than the stream holds, written again when it is full
+		Network late(31);
+		InputStream full;
+		late.setInputStream(&full);
+		
+		vector<InputCommand> sent;
+		for (uint32_t t(0); t<500; ++t)
+		{
+			for (uint32_t i(0); i<10; ++i)
+			{
+				sent.push_back(InputCommand{t, i, (t >= 100 and t < 300) ? 1.01 : 0.0});
+			}
+		}
+		ASSERT_GT(sent.size(), InputStream::capacity());
+		
+		size_t next(0);
+		bool refused(false);
+		for (int k(0); k<500; ++k)
+		{
+			while(next < sent.size() and full.write(sent[next]))
+			{
+				++next;
+			}
+			refused = refused or next < sent.size();
+			full.publish();
+			late.step();
+		}
+		EXPECT_TRUE(refused);
+		EXPECT_EQ(next, sent.size());
+		EXPECT_EQ(full.getDropped(), 0);
+		EXPECT_EQ(late.getSpikeTrains(), stimulated.getSpikeTrains());
+		
+		//commands sent by a controller thread answering each step
+		Network reference(37), controlled(37);
+		reference.addStimulus(Stimulus::step(1.01, 51, 200), 0, 1);
+		
+		SpikeStream spikes;
+		InputStream commands;
+		controlled.setSpikeStream(&spikes);
+		controlled.setInputStream(&commands, true);
+		
+		thread controller([&]()
+		{
+			commands.write(InputCommand{0, endOfStep, 0.0});
+			commands.publish();
+			
+			for (uint32_t t(0); t<200; )
+			{
+				const SpikeEvent* events;
+				size_t n = spikes.read(events);
+				for (size_t e(0); e<n; ++e)
+				{
+					if(events[e].neuron != endOfStep)
+					{
+						continue;
+					}
+					
+					//the current has to be applied from the next step on
+					++t;
+					if(t == 51)
+					{
+						commands.writeWait(InputCommand{t, 0, 1.01});
+					}
+					commands.writeWait(InputCommand{t, endOfStep, 0.0});
+					commands.publish();
+				}
+				spikes.release(n);
+				
+				if(n == 0)
+				{
+					this_thread::yield();
+				}
+			}
+		});
+		
+		controlled.step(200);
+		controller.join();
+		reference.runSimulation(200);
+		
+		EXPECT_EQ(controlled.getSpikeTrains(), reference.getSpikeTrains());
+	}
+
+	/*
+	 * test if the transposed map gives the same connections as the
+	 * connection map, with any number of workers
+	 */
+	TEST (NetworkTest, incomingConnections)
+	{
+		Network net(11);
+		vector< vector<int> > map = net.getConnectionMap();
+		
+		for (unsigned int workers(1); workers<=4; ++workers)
+		{
+			net.buildIncoming(workers);
+			
+			vector< vector<int> > incoming(N);
+			for (int i(0); i<N; ++i)
+			{
+				for (size_t j(0); j<map[i].size(); ++j)
+				{
+					incoming[map[i][j]].push_back(i);
+				}
+			}
+			
+			for (unsigned int n(0); n<N; ++n)
+			{
+				EXPECT_EQ(net.getInDegree(n), Ctot);
+				EXPECT_EQ(net.getPresynaptic(n), incoming[n]);
+			}
+		}
+	}
+
+	/*
+	 * test if a probe takes the right number of samples without changing
+	 * the simulation
+	 */
+	TEST (NetworkTest, probe)
+	{
+		Network a(5),
+				b(5);
+		
+		size_t p = a.addProbe(10, 10);
+		
+		a.runSimulation(1000);
+		b.runSimulation(1000);
+		
+		EXPECT_EQ(a.getSpikeTrains(), b.getSpikeTrains());
+		EXPECT_EQ(a.getProbePotential(p).size(), 100);
+		EXPECT_EQ(a.getProbeInput(p).size(), 100);
+		EXPECT_EQ(a.getProbeTimes(p)[1], 10);
+		EXPECT_EQ(a.getNeurons()[10].getMembranePotential(),
+				  b.getNeurons()[10].getMembranePotential());
+		
+		//the same samples are taken one step at a time, in about as much memory
+		Network c(5);
+		size_t q = c.addProbe(10, 10);
+		
+		for (int t(0); t<1000; ++t)
+		{
+			c.step(1);
+		}
+		
+		EXPECT_EQ(c.getProbePotential(q), a.getProbePotential(p));
+		EXPECT_EQ(c.getProbeInput(q), a.getProbeInput(p));
+		EXPECT_LE(c.getFootprint(), a.getFootprint() + a.getFootprint()/8);
+	}
+
+	/*
+	 * test if a step current injected in a neuron of the network makes it
+	 * spike like a single neuron with the same current
+	 * (with N=50 the network itself is almost silent)
+	 */
+	TEST (NetworkTest, stimulus)
+	{
+		Network net(13);
+		net.addStimulus(Stimulus::step(1.01, 0, 5000), 0, N);
+		net.runSimulation(5000);
+		
+		vector<Neuron> list = net.getNeurons();
+		for (size_t i(0); i<list.size(); ++i)
+		{
+			EXPECT_GE(list[i].getNumberOfSpike(), 5);
+		}
+	}
+
+	/*
+	 * test if the plastic weights change only on the E->E synapses and
+	 * stay between 0 and J_max
+	 */
+	TEST (NetworkTest, plasticity)
+	{
+		Network net(17);
+		net.enablePlasticity();
+		net.addStimulus(Stimulus::step(1.01, 0, 5000), 0, N);
+		net.runSimulation(5000);
+
+		vector< vector<int> > map = net.getConnectionMap();
+		size_t changed(0);
+
+		for (int i(0); i<N; ++i)
+		{
+			vector<double> w = net.getWeights(i);
+			ASSERT_EQ(w.size(), map[i].size());
+
+			for (size_t j(0); j<w.size(); ++j)
+			{
+				if(i >= Ne)
+				{
+					EXPECT_EQ(w[j], Ji);
+				}
+				else if(map[i][j] >= Ne)
+				{
+					EXPECT_FLOAT_EQ(w[j], Je);
+				}
+				else
+				{
+					EXPECT_GE(w[j], 0.0);
+					EXPECT_LE(w[j], float(J_max));
+					changed += (fabs(w[j]-Je) > 1e-6);
+				}
+			}
+		}
+		EXPECT_GT(changed, 0);
+	}
+
+	/*
+	 * test the connections of a network of fixed size 40/10, if it gives
+	 * the same spikes as neurons linked by hand with its connections and
+	 * its noise, and at the size N if it gives the spikes of a network
+	 * built with the same seed
+	 */
+	TEST (NetworkTest, fixedSize)
+	{
+		typedef FixedNetwork<40, 10> Small;
+		
+		EXPECT_EQ(Small::CE, 4);
+		EXPECT_EQ(Small::CI, 1);
+		
+		Small small(19);
+		vector< vector<int> > map = small.getConnectionMap();
+		
+		vector<int> E(Small::NN, 0),
+					I(Small::NN, 0);
+		for (int i(0); i<Small::NN; ++i)
+		{
+			for (size_t j(0); j<map[i].size(); ++j)
+			{
+				++((i < 40) ? E : I)[map[i][j]];
+			}
+		}
+		for (int n(0); n<Small::NN; ++n)
+		{
+			EXPECT_EQ(E[n], Small::CE);
+			EXPECT_EQ(I[n], Small::CI);
+		}
+		
+		small.setCurrent(1.01);
+		small.runSimulation(5000);
+		EXPECT_GE(small.getNumberOfSpike(), 5*Small::NN);
+		
+		/*
+		 * the noise follows the drawing of the connections in the
+		 * generator, the neurons are updated and deliver their spikes
+		 * like in NetworkT
+		 */
+		mt19937 gen(19);
+		drawConnections(gen, 40, Small::NN, Small::CE, Small::CI, [](int, int){});
+		
+		poisson_distribution<int> noise(V_ext*Small::CE);
+		vector<Neuron> neurons;
+		for (int i(0); i<Small::NN; ++i)
+		{
+			neurons.push_back(Neuron((i < 40) ? ::E : ::I));
+		}
+		
+		for (int t(0); t<5000; ++t)
+		{
+			for (int i(0); i<Small::NN; ++i)
+			{
+				double Jext = neurons[i].integrates() ? noise(gen)*Je : 0.0;
+				if(neurons[i].step(1.01, Jext))
+				{
+					for (size_t j(0); j<map[i].size(); ++j)
+					{
+						neurons[map[i][j]].setBufferAt(t+D, (i < 40) ? Je : Ji);
+					}
+				}
+			}
+		}
+		
+		vector< vector<double> > trains = small.getSpikeTrains();
+		for (int i(0); i<Small::NN; ++i)
+		{
+			EXPECT_EQ(neurons[i].getSpikeTimes(), trains[i]);
+		}
+		
+		//at the size of constant.hpp it is the network built with the same seed
+		typedef FixedNetwork<Ne, Ni> Full;
+		unique_ptr<Full> full(new Full(19));
+		full->setCurrent(1.01);
+		full->runSimulation(500);
+		
+		Network net(19);
+		net.addStimulus(Stimulus::step(1.01, 0, 500), 0, N);
+		net.runSimulation(500);
+		
+		EXPECT_GT(net.getNumberOfSpike(), 0);
+		EXPECT_EQ(net.getConnectionMap(), full->getConnectionMap());
+		EXPECT_EQ(net.getSpikeTrains(), full->getSpikeTrains());
+	}
+
+	/*
+	 * test the populations and the connections of a network of two areas
+	 * linked by sparse projections
+	 */
+	TEST (AreaNetworkTest, projections)
+	{
+		NetworkBuilder builder;
+		unsigned int v1 = builder.addArea("V1", 80, 20);
+		unsigned int v2 = builder.addArea("V2", 80, 20);
+		unsigned int input = builder.addPopulation("input", 30, E, 20.0);
+		
+		EXPECT_TRUE(builder.addProjection(v1, v2, PROBABILITY, 0.05, Je, 10));
+		EXPECT_TRUE(builder.addProjection(v2, v1, IN_DEGREE, 2, Je, 5));
+		EXPECT_TRUE(builder.addProjection(input, v1+1, PROBABILITY, 1.0, 2*Je, 1));
+		
+		//invalid delay, probability and in-degrees
+		EXPECT_FALSE(builder.addProjection(v1, v2, PROBABILITY, 0.1, Je, 0));
+		EXPECT_FALSE(builder.addProjection(v1, v2, PROBABILITY, 1.5, Je));
+		EXPECT_FALSE(builder.addProjection(v1, v2, IN_DEGREE, 2.5, Je));
+		unsigned int single = builder.addPopulation("single", 1, I);
+		EXPECT_FALSE(builder.addProjection(single, single, IN_DEGREE, 1, Ji));
+		
+		EXPECT_EQ(builder.findPopulation("V2.I"), int(v2+1));
+		EXPECT_EQ(builder.findPopulation("V3.E"), -1);
+		EXPECT_EQ(builder.getNumberOfNeurons(), 231);
+		EXPECT_EQ(builder.getProjections().size(), 11);
+		
+		AreaNetwork net(builder, 41);
+		ASSERT_EQ(net.getNumberOfNeurons(), 231);
+		
+		const vector<Population>& pops = net.getPopulations();
+		const vector<Projection>& projs = net.getProjections();
+		EXPECT_EQ(pops[v2].begin, 100);
+		EXPECT_EQ(pops[input].end, 230);
+		
+		size_t total(0);
+		for (size_t p(0); p<projs.size(); ++p)
+		{
+			const Population& source = pops[projs[p].source];
+			const Population& target = pops[projs[p].target];
+			vector<int> indegree(net.getNumberOfNeurons(), 0);
+			size_t count(0);
+			
+			for (unsigned int pre(source.begin); pre<source.end; ++pre)
+			{
+				vector<int> row = net.getTargets(p, pre);
+				EXPECT_TRUE(is_sorted(row.begin(), row.end()));
+				
+				for (size_t j(0); j<row.size(); ++j)
+				{
+					EXPECT_GE(row[j], int(target.begin));
+					EXPECT_LT(row[j], int(target.end));
+					EXPECT_NE(row[j], int(pre));
+					++indegree[row[j]];
+				}
+				count += row.size();
+			}
+			
+			EXPECT_EQ(count, net.getNumberOfConnections(p));
+			total += count;
+			
+			if(projs[p].rule == IN_DEGREE)
+			{
+				for (unsigned int post(target.begin); post<target.end; ++post)
+				{
+					EXPECT_EQ(indegree[post], projs[p].value);
+				}
+			}
+		}
+		EXPECT_EQ(total, net.getNumberOfConnections());
+		
+		//the sparse projection only has about 5% of its pairs
+		EXPECT_GT(net.getNumberOfConnections(8), 200);
+		EXPECT_LT(net.getNumberOfConnections(8), 450);
+		EXPECT_EQ(net.getNumberOfConnections(10), 30*20);
+		
+		//the input drives the inhibitory neurons of V1
+		net.runSimulation(1000);
+		EXPECT_EQ(net.getClock(), 1000);
+		
+		vector< vector<double> > trains = net.getSpikeTrains();
+		size_t spikes(0);
+		for (size_t i(0); i<trains.size(); ++i)
+		{
+			spikes += trains[i].size();
+		}
+		EXPECT_EQ(spikes, net.getNumberOfSpike());
+		EXPECT_GT(spikes, 0);
+	}
+
+	//////////////////////////
+	//						//
+	//	 Controller Tests	//
+	//						//
+	//////////////////////////
+
+	/*
+	 * test if each stop condition of a controlled run triggers: a network
+	 * without external noise nor current is silent, a driven one blows up
+	 * or gives its sample depending on the thresholds set
+	 */
+	TEST (RunControllerTest, earlyStop)
+	{
+		Network quiet(13);
+		quiet.setExternalNoise(false);
+		RunController a(quiet);
+		a.setSilence(0.1);
+		a.setBlowUp(1000);
+		
+		EXPECT_EQ(a.run(100000), SILENCE);
+		EXPECT_LT(a.getStopTime(), 100000);
+		EXPECT_EQ(a.getStopTime(), quiet.getClock());
+		EXPECT_EQ(quiet.getNumberOfSpike(), 0);
+		
+		//a current of 1.01 makes every neuron fire regularly
+		Network driven(13);
+		driven.setExternalNoise(false);
+		driven.addStimulus(Stimulus::step(1.01, 0, 100000), 0, N);
+		RunController b(driven);
+		b.setSilence(0.1);
+		b.setBlowUp(1000);
+		b.setTargetSpikes(100);
+		
+		EXPECT_EQ(b.run(100000), SAMPLE_SIZE);
+		EXPECT_GE(b.getRecordedSpikes(), 100);
+		EXPECT_EQ(b.getRecordedSpikes(), driven.getNumberOfSpike());
+		
+		Network hot(13);
+		hot.setExternalNoise(false);
+		hot.addStimulus(Stimulus::step(1.01, 0, 100000), 0, N);
+		RunController c(hot);
+		c.setSilence(0.1);
+		c.setBlowUp(1);
+		
+		EXPECT_EQ(c.run(100000), BLOW_UP);
+		EXPECT_LT(c.getStopTime(), 100000);
+	}
+
+	//////////////////////
+	//					//
+	//	 Arena Tests	//
+	//					//
+	//////////////////////
+
+	/*
+	 * test if a small block given back to the arena is reused, and if a
+	 * big one is given back to the system (the footprint accounts for the
+	 * mapped memory)
+	 */
+	TEST (ArenaTest, reuse)
+	{
+		Arena arena;
+		
+		EXPECT_EQ(arena.getFootprint(), 0);
+		
+		void* a = arena.allocate(100);
+		EXPECT_GE(arena.getFootprint(), 100);
+		EXPECT_EQ(arena.getUsed(), 128);
+		
+		arena.deallocate(a, 100);
+		EXPECT_EQ(arena.getUsed(), 0);
+		
+		void* b = arena.allocate(120);
+		EXPECT_EQ(a, b);
+		arena.deallocate(b, 120);
+		
+		//a big block is given back to the system and can be allocated again
+		size_t before = arena.getFootprint();
+		for (int k(0); k<10; ++k)
+		{
+			void* big = arena.allocate(3 << 20);
+			EXPECT_EQ(arena.getUsed(), size_t(3 << 20));
+			EXPECT_EQ(arena.getFootprint(), before + (3 << 20));
+			static_cast<char*>(big)[(3 << 20)-1] = 1;
+			arena.deallocate(big, 3 << 20);
+			EXPECT_EQ(arena.getUsed(), 0);
+			EXPECT_EQ(arena.getFootprint(), before);
+		}
+	}
+
+	//////////////////////////
+	//						//
+	//	 Stimulus Tests		//
+	//						//
+	//////////////////////////
+
+	/*
+	 * test the value of each shape of current inside and outside of the
+	 * time it is applied
+	 */
+	TEST (StimulusTest, shapes)
+	{
+		Stimulus step = Stimulus::step(2.0, 10, 20);
+		EXPECT_EQ(step.getCurrent(9), 0.0);
+		EXPECT_EQ(step.getCurrent(10), 2.0);
+		EXPECT_EQ(step.getCurrent(20), 0.0);
+		
+		Stimulus ramp = Stimulus::ramp(0.0, 1.0, 0, 100);
+		EXPECT_DOUBLE_EQ(ramp.getCurrent(50), 0.5);
+		
+		//10Hz sinusoid: a quarter of period is 25ms (250 steps)
+		Stimulus sine = Stimulus::sine(1.0, 10.0, 0.0, 0, 10000);
+		EXPECT_NEAR(sine.getCurrent(250), 1.0, 1e-12);
+		
+		Stimulus wave = Stimulus::waveform(vector<double>{1.0, 2.0, 3.0}, 5, 2);
+		EXPECT_EQ(wave.getCurrent(7), 2.0);
+		EXPECT_EQ(wave.getCurrent(11), 0.0);
+	}
+
+	/*
+	 * test if the status published during a run matches the network in
+	 * push and pull mode, and if a report gives the step reached
+	 */
+	TEST (ProgressTest, status)
+	{
+		Network push(13),
+				pull(13);
+		push.addStimulus(Stimulus::step(1.01, 0, 2000), 0, N);
+		pull.addStimulus(Stimulus::step(1.01, 0, 2000), 0, N);
+		pull.setDeliveryMode(PULL, 2);
+		
+		ostringstream out;
+		ProgressReporter progress(push, 0.0, out);
+		
+		push.runSimulation(2000);
+		pull.runSimulation(2000);
+		
+		EXPECT_EQ(push.getStatus().clock, 2000);
+		EXPECT_EQ(push.getStatus().spikes, push.getNumberOfSpike());
+		EXPECT_EQ(pull.getStatus().spikes, pull.getNumberOfSpike());
+		EXPECT_EQ(progress.report().find("step 2000/2000 (100.0%)"), 0);
+	}
+
+	//////////////////////////
+	//						//
+	//	 Spike Store Tests	//
+	//						//
+	//////////////////////////
+
+	/*
+	 * test if a range query on a spike store gives the same spikes as a
+	 * scan of the spike trains
+	 */
+	TEST (SpikeStoreTest, rangeQuery)
+	{
+		Network net(13);
+		net.addStimulus(Stimulus::step(1.01, 0, 5000), 0, N);
+		net.runSimulation(5000);
+		net.saveSpikeStore("test_spikes.spk", 300);
+		
+		vector< vector<double> > trains = net.getSpikeTrains();
+		SpikeStore store("test_spikes.spk");
+		
+		ASSERT_TRUE(store.isOpen());
+		EXPECT_EQ(store.getNumberOfNeurons(), N);
+		EXPECT_EQ(store.getNumberOfSpike(), net.getNumberOfSpike());
+		EXPECT_EQ(store.getNumberOfSpike(3), trains[3].size());
+		
+		unsigned int first(N/4), last(N/2), begin(1234), end(3456);
+		vector< vector<double> > expected(last-first);
+		for (unsigned int i(first); i<last; ++i)
+		{
+			for (size_t k(0); k<trains[i].size(); ++k)
+			{
+				if(trains[i][k] >= begin and trains[i][k] < end)
+				{
+					expected[i-first].push_back(trains[i][k]);
+				}
+			}
+		}
+		
+		EXPECT_EQ(store.getSpikeTrains(first, last, begin, end), expected);
+		EXPECT_EQ(store.getSpikeTrains(0, N, 0, 5000), trains);
+		EXPECT_EQ(store.getSpikeTrains(first, first+1, begin, end)[0], expected[0]);
+		
+		//more spikes than the writer copies at once, blocks of 7 steps
+		vector< vector<double> > dense(3);
+		for (unsigned int t(0); t<40000; ++t)
+		{
+			for (unsigned int i(0); i<3; ++i)
+			{
+				if(t%(i+1) == 0)
+				{
+					dense[i].push_back(t);
+				}
+			}
+		}
+		SpikeStore::write("test_spikes.spk", dense, 40000, 7);
+		SpikeStore big("test_spikes.spk");
+		
+		ASSERT_TRUE(big.isOpen());
+		EXPECT_EQ(big.getNumberOfSpike(), 73334);
+		EXPECT_EQ(big.getSpikeTrains(0, 3, 0, 40000), dense);
+		
+		vector<double> middle;
+		for (unsigned int t(10002); t<30000; t += 2)
+		{
+			middle.push_back(t);
+		}
+		EXPECT_EQ(big.getSpikeTrains(1, 2, 10001, 30000)[0], middle);
+		
+		remove("test_spikes.spk");
+	}
+
+	//////////////////////////
+	//						//
+	//	 Spike Text Tests	//
+	//						//
+	//////////////////////////
+
+	/*
+	 * test if the spike lines are written like an ostream writes them,
+	 * below and above 10^6 steps
+	 */
+	TEST (SpikeTextTest, textFormat)
+	{
+		ostringstream expected;
+		char line[spikeLineSize];
+		
+		for (double t(0); t<3000000; t += (t < 2000) ? 1 : 997)
+		{
+			expected.str("");
+			expected << t/100 << "\t" << 12499 << "\n";
+			
+			char* end = formatSpikeLine(t, 12499, line);
+			EXPECT_EQ(string(line, end), expected.str());
+		}
+	}
+
+	/*
+	 * test if the spike lines are read back, whatever the parts the text
+	 * is cut in, and if the malformed lines are skipped
+	 */
+	TEST (SpikeTextTest, textParse)
+	{
+		string text;
+		vector<SpikeLine> expected;
+		char line[spikeLineSize];
+		
+		for (double t(0); t<3000000000.0; t = t*3 + 7)
+		{
+			SpikeLine s = {int(t)%12500, t};
+			text += string(line, formatSpikeLine(t, s.neuron, line));
+			
+			//%g keeps 6 digits, the time read is the one written
+			if(t >= 1000000)
+			{
+				s.time = floor(atof(string(line, formatSpikeTime(t, line)).c_str())*100 + 0.5);
+			}
+			expected.push_back(s);
+			
+			if(expected.size() == 3)
+			{
+				text += "abc\n\t12\n1.5\n-3\t-1\n\r\n\n";
+			}
+		}
+		
+		//the last line has no end of line
+		text += "2.5 7";
+		SpikeLine last = {7, 250};
+		expected.push_back(last);
+		
+		for (size_t parts(1); parts<=9; ++parts)
+		{
+			vector<const char*> cuts = cutSpikeText(text.data(), text.size(), parts);
+			vector<SpikeLine> read;
+			
+			for (size_t w(0); w<parts; ++w)
+			{
+				EXPECT_LE(cuts[w], cuts[w+1]);
+				parseSpikeText(cuts[w], cuts[w+1], read);
+			}
+			
+			ASSERT_EQ(read.size(), expected.size());
+			for (size_t k(0); k<read.size(); ++k)
+			{
+				EXPECT_EQ(read[k].neuron, expected[k].neuron);
+				EXPECT_EQ(read[k].time, expected[k].time);
+			}
+		}
+		
+		double value(0.0);
+		const char* number = "-1.25e+2x";
+		const char* p = number;
+		EXPECT_TRUE(readSpikeNumber(p, number+9, value));
+		EXPECT_DOUBLE_EQ(value, -125.0);
+		EXPECT_EQ(*p, 'x');
+		EXPECT_FALSE(readSpikeNumber(p, number+9, value));
+	}
+
+	//////////////////////////
+	//						//
+	//	 Noise Tape Tests	//
+	//						//
+	//////////////////////////
+
+	/*
+	 * test if a network replaying the noise of a record gives its spikes
+	 * again, with the push and with the parallel pull delivery
+	 */
+	TEST (NoiseTapeTest, replay)
+	{
+		delivery_mode modes[] = {PUSH, PULL};
+		
+		for (int m(0); m<2; ++m)
+		{
+			Network recorded(43), replayed(43);
+			recorded.setDeliveryMode(modes[m], 2);
+			replayed.setDeliveryMode(modes[m], 2);
+			recorded.addStimulus(Stimulus::step(1.01, 0, 1000), 0, N);
+			replayed.addStimulus(Stimulus::step(1.01, 0, 1000), 0, N);
+			
+			ASSERT_TRUE(recorded.recordNoise("test_noise.tape"));
+			recorded.runSimulation(800);
+			recorded.stopNoise();
+			
+			NoiseTape tape("test_noise.tape");
+			ASSERT_TRUE(tape.isOpen());
+			EXPECT_EQ(tape.getNumberOfNeurons(), N);
+			EXPECT_EQ(tape.getStart(), 0);
+			EXPECT_EQ(tape.getNumberOfSteps(), 800);
+			
+			//after the record the replayed network draws its own noise
+			ASSERT_TRUE(replayed.replayNoise("test_noise.tape"));
+			replayed.runSimulation(800);
+			EXPECT_EQ(replayed.getSpikeTrains(), recorded.getSpikeTrains());
+			replayed.runSimulation(1000);
+			EXPECT_GT(replayed.getNumberOfSpike(), 0);
+		}
+		
+		//the numbers that do not fit in a byte are kept apart
+		{
+			NoiseRecorder recorder("test_noise.tape", 4, 10, 0.0);
+			int counts[3][4] = {{0, 254, 255, 1000}, {3, 2, 1, 0}, {70000, 0, 0, 7}};
+			for (int t(0); t<3; ++t)
+			{
+				for (int i(0); i<4; ++i)
+				{
+					recorder.set(i, counts[t][i]);
+				}
+				recorder.endStep();
+			}
+			EXPECT_TRUE(recorder.close());
+			
+			NoiseTape tape("test_noise.tape");
+			ASSERT_TRUE(tape.isOpen());
+			EXPECT_FALSE(tape.hasStep(9));
+			EXPECT_FALSE(tape.hasStep(13));
+			for (int t(0); t<3; ++t)
+			{
+				ASSERT_TRUE(tape.hasStep(10+t));
+				for (int i(0); i<4; ++i)
+				{
+					EXPECT_EQ(tape.get(10+t, i), counts[t][i]);
+				}
+			}
+		}
+		
+		//a record of an other size is refused
+		Network other(43);
+		EXPECT_FALSE(other.replayNoise("test_noise.tape"));
+		
+		remove("test_noise.tape");
+	}
+
+	//////////////////////////
+	//						//
+	//	Statistics Tests	//
+	//						//
+	//////////////////////////
+
+	/*
+	 * test the rate and the CV of a perfectly regular neuron spiking
+	 * every 10ms during 1s
+	 */
+	TEST (StatisticsTest, regularSpikeTrain)
+	{
+		vector< vector<double> > spikes(1);
+		for (int t(0); t<10000; t += 100)
+		{
+			spikes[0].push_back(t);
+		}
+		
+		Statistics s(spikes, 10000);
+		
+		EXPECT_EQ(s.getNumberOfSpike(), 100);
+		EXPECT_DOUBLE_EQ(s.getMeanRate(), 100.0);
+		EXPECT_NEAR(s.getMeanCV(), 0.0, 1e-12);
+	}
+
+	/*
+	 * test if the spectrum of a population firing in waves every 10ms
+	 * peaks at 100Hz
+	 */
+	TEST (StatisticsTest, powerSpectrum)
+	{
+		//each neuron fires once per wave, the waves last 5ms
+		vector< vector<double> > spikes(50);
+		for (size_t i(0); i<spikes.size(); ++i)
+		{
+			for (int t(0); t<10000; t += 100)
+			{
+				spikes[i].push_back(t + 10*(i%5));
+			}
+		}
+		
+		Statistics s(spikes, 10000);
+		vector<double> power = s.getPowerSpectrum(10);
+		double df = s.getFrequencyResolution(10);
+		
+		size_t peak = max_element(power.begin()+1, power.end()) - power.begin();
+		EXPECT_NEAR(peak*df, 100.0, df);
+	}
+	
+	/*
+	 * test the synchrony index of identical and of independent Poisson
+	 * spike trains
+	 */
+	TEST (StatisticsTest, synchrony)
+	{
+		mt19937 gen(3);
+		bernoulli_distribution fire(0.002);
+		
+		vector< vector<double> > independent(200),
+								 identical(200);
+		for (size_t i(0); i<independent.size(); ++i)
+		{
+			for (int t(0); t<100000; ++t)
+			{
+				if(fire(gen))
+				{
+					independent[i].push_back(t);
+				}
+			}
+			identical[i] = independent[0];
+		}
+		
+		EXPECT_NEAR(Statistics(identical, 100000).getSynchrony(10), 1.0, 1e-9);
+		EXPECT_NEAR(Statistics(independent, 100000, 4).getSynchrony(10), 1/sqrt(200.0), 0.03);
+	}
+	
+	/*
+	 * test if the correlation of a spike train with a copy of itself 3ms
+	 * later peaks at a lag of 3 bins of 1ms
+	 */
+	TEST (StatisticsTest, crossCorrelation)
+	{
+		mt19937 gen(5);
+		bernoulli_distribution fire(0.002);
+		
+		vector< vector<double> > spikes(2);
+		for (int t(0); t<100000; ++t)
+		{
+			if(fire(gen))
+			{
+				spikes[0].push_back(t);
+				if(t+30 < 100000)
+				{
+					spikes[1].push_back(t+30);
+				}
+			}
+		}
+		
+		Statistics s(spikes, 100000);
+		
+		//the only pair is drawn in one of its two orders
+		int peak(0);
+		double best(-1.0);
+		for (int lag(-8); lag<=8; ++lag)
+		{
+			vector<double> c = s.getCrossCorrelation(1, 10, 1, lag);
+			ASSERT_EQ(c.size(), 1);
+			
+			if(c[0] > best)
+			{
+				best = c[0];
+				peak = lag;
+			}
+			if(abs(lag) != 3)
+			{
+				EXPECT_LT(fabs(c[0]), 0.1);
+			}
+		}
+		
+		EXPECT_EQ(abs(peak), 3);
+		EXPECT_NEAR(best, 1.0, 1e-9);
+		
+		//neurons firing together are fully correlated without lag
+		spikes[1] = spikes[0];
+		vector<double> c = Statistics(spikes, 100000).getCrossCorrelation(10, 10);
+		ASSERT_EQ(c.size(), 10);
+		EXPECT_NEAR(c[3], 1.0, 1e-9);
+	}
@@ -0,0 +1,308 @@
+#include "network.hpp"
+#include "statistics.hpp"
+#include "wiring.hpp"
+
+#include <iostream>
+#include <cstdlib>
+#include <cstdio>
+#include <cmath>
+#include <vector>
+#include <string>
+
+using namespace std;
+
+/*
+ * validation programm
+ *
+ * runs the reference simulation (Network::update with its push delivery)
+ * and every candidate engine on the same seeded network and compares
+ * their spikes.
+ * A candidate that is expected to reproduce the reference exactly has to
+ * produce the very same spike times (a few candidates are compared with
+ * an other engine rather than the reference, like the batched delivery
+ * which has to give the spikes of the pull delivery with one worker); the others have to agree within
+ * tolerance on the mean rate, the mean CV of the inter-spike intervals
+ * and the spectrum of the population rate.
+ *
+ * the reference draws the noise of a neuron only when it integrates it,
+ * like the first version of Network::update, which is run as the
+ * "baseline update" candidate with its own unseeded noise
+ *
+ * use: ./validation [t_stop] [seed]
+ * the programm returns the number of candidates that failed
+ */
+
+//tolerated relative difference of the mean rates
+static const double rateTolerance(0.05);
+
+//tolerated absolute difference of the mean CVs
+static const double cvTolerance(0.05);
+
+//tolerated distance between the two normalised population spectra (0..1)
+static const double spectrumTolerance(0.25);
+
+//width of a bin of the population rate (1ms)
+static const unsigned int spectrumBin(10);
+
+//number of frequency bands compared in the population spectra
+static const size_t spectrumBands(25);
+
+/*
+ * an engine runs a network built with a given seed until t_stop and
+ * returns the spike times of each of its neurons
+ */
+typedef vector< vector<double> > (*engine)(unsigned int seed, unsigned int t_stop);
+
+struct Candidate
+{
+	//name displayed in the report
+	string name;
+
+	//engine to compare with the reference
+	engine run;
+
+	//true if the spikes have to be identical to the reference ones
+	bool exact;
+
+	//the candidate is run with the seed of the reference plus this offset
+	unsigned int seedOffset;
+
+	//engine compared with instead of the reference (null for the reference)
+	engine base;
+};
+
+	//////////////////////////////
+	//                          //
+	//			Engines			//
+	//                          //
+	//////////////////////////////
+
+vector< vector<double> > reference(unsigned int seed, unsigned int t_stop)
+{
+	Network net(seed);
+	net.runSimulation(t_stop);
+	return net.getSpikeTrains();
+}
+
+vector< vector<double> > baseline(unsigned int seed, unsigned int t_stop)
+{
+	/*
+	 * the first version of the simulation: each neuron draws its own noise
+	 * with Neuron::update (from a generator that is not seeded) and its
+	 * spikes are delivered at once
+	 */
+	mt19937 gen(seed);
+	vector< vector<int> > map(N);
+	drawConnections(gen, Ne, N, Ce, Ci, [&](int pre, int post)
+	{
+		map[pre].push_back(post);
+	});
+
+	vector<Neuron> neurons;
+	for (int i(0); i<N; ++i)
+	{
+		neurons.push_back(Neuron((i < Ne) ? E : I));
+	}
+
+	for (unsigned int t(0); t<t_stop; ++t)
+	{
+		for (int i(0); i<N; ++i)
+		{
+			if(neurons[i].update(0.0, true))
+			{
+				for (size_t j(0); j<map[i].size(); ++j)
+				{
+					neurons[map[i][j]].setBufferAt(t+D, (i < Ne) ? Je : Ji);
+				}
+			}
+		}
+	}
+
+	vector< vector<double> > trains(N);
+	for (int i(0); i<N; ++i)
+	{
+		trains[i] = neurons[i].getSpikeTimes();
+	}
+	return trains;
+}
+
+vector< vector<double> > pullSingle(unsigned int seed, unsigned int t_stop)
+{
+	Network net(seed);
+	net.setDeliveryMode(PULL, 1);
+	net.runSimulation(t_stop);
+	return net.getSpikeTrains();
+}
+
+vector< vector<double> > pullParallel(unsigned int seed, unsigned int t_stop)
+{
+	Network net(seed);
+	net.setDeliveryMode(PULL, 4);
+	net.runSimulation(t_stop);
+	return net.getSpikeTrains();
+}
+
+vector< vector<double> > batched(unsigned int seed, unsigned int t_stop)
+{
+	Network net(seed);
+	net.setDeliveryMode(BATCHED);
+	net.runSimulation(t_stop);
+	return net.getSpikeTrains();
+}
+
+vector< vector<double> > replayed(unsigned int seed, unsigned int t_stop)
+{
+	//the noise of a first run is recorded and replayed by a second one
+	{
+		Network net(seed);
+		net.recordNoise("validation_noise.tape");
+		net.runSimulation(t_stop);
+	}
+
+	Network net(seed);
+	net.replayNoise("validation_noise.tape");
+	net.runSimulation(t_stop);
+	remove("validation_noise.tape");
+
+	return net.getSpikeTrains();
+}
+
+	//////////////////////////////
+	//                          //
+	//		  Comparison		//
+	//                          //
+	//////////////////////////////
+
+/*
+ * groups a power spectrum in bands and normalises it to a total of 1
+ */
+vector<double> bands(const vector<double>& power)
+{
+	vector<double> b(spectrumBands, 0.0);
+	double total(0.0);
+
+	//the constant component is removed
+	for (size_t k(1); k<power.size(); ++k)
+	{
+		b[(k-1)*spectrumBands/power.size()] += power[k];
+		total += power[k];
+	}
+
+	if(total > 0)
+	{
+		for (size_t i(0); i<b.size(); ++i)
+		{
+			b[i] /= total;
+		}
+	}
+	return b;
+}
+
+/*
+ * compares the spikes of a candidate with the reference ones, displays the
+ * result in the terminal and returns true if the candidate is accepted
+ */
+bool compare(const Candidate& c,
+			 const vector< vector<double> >& ref,
+			 const vector< vector<double> >& cand,
+			 unsigned int t_stop)
+{
+	bool ok(true);
+
+	cout << "---" << c.name << "---" << endl;
+
+	if(c.exact)
+	{
+		size_t mismatch(0);
+		while(mismatch < ref.size() and mismatch < cand.size()
+			  and ref[mismatch] == cand[mismatch])
+		{
+			++mismatch;
+		}
+		bool identical = (ref.size() == cand.size() and mismatch == ref.size());
+
+		cout << "bit-exact    " << (identical ? "yes" : "NO");
+		if(!identical)
+		{
+			cout << " (first difference at neuron " << mismatch << ")";
+		}
+		cout << endl;
+		ok = identical;
+	}
+
+	Statistics r(ref, t_stop),
+			   s(cand, t_stop);
+
+	double rateR = r.getMeanRate(),
+		   rateS = s.getMeanRate();
+	double rateDiff = (rateR > 0) ? fabs(rateS-rateR)/rateR : fabs(rateS);
+	bool rateOk = rateDiff <= rateTolerance;
+
+	double cvR = r.getMeanCV(),
+		   cvS = s.getMeanCV();
+	bool cvOk = fabs(cvS-cvR) <= cvTolerance;
+
+	vector<double> bandR = bands(r.getPowerSpectrum(spectrumBin)),
+				   bandS = bands(s.getPowerSpectrum(spectrumBin));
+	double distance(0.0);
+	for (size_t i(0); i<spectrumBands; ++i)
+	{
+		distance += fabs(bandR[i]-bandS[i]);
+	}
+	distance /= 2;
+	bool spectrumOk = distance <= spectrumTolerance;
+
+	cout << "spikes       " << r.getNumberOfSpike() << " / " << s.getNumberOfSpike() << endl;
+	cout << "rate         " << rateR << "Hz / " << rateS << "Hz"
+		 << (rateOk ? "" : "  OUT OF TOLERANCE") << endl;
+	cout << "CV           " << cvR << " / " << cvS
+		 << (cvOk ? "" : "  OUT OF TOLERANCE") << endl;
+	cout << "spectrum     distance " << distance
+		 << (spectrumOk ? "" : "  OUT OF TOLERANCE") << endl;
+
+	ok = ok and rateOk and cvOk and spectrumOk;
+
+	cout << (ok ? "ACCEPTED" : "REJECTED") << endl << endl;
+
+	return ok;
+}
+
+int main(int argc, char **argv)
+{
+	unsigned int t_stop = (argc > 1) ? atoi(argv[1]) : 2000;
+	unsigned int seed = (argc > 2) ? atoi(argv[2]) : 1;
+
+	/*
+	 * the reference run again with the same seed checks that a seeded
+	 * simulation is reproducible, and with an other seed that the
+	 * tolerances accept a statistically equivalent network
+	 */
+	vector<Candidate> candidates = {
+		{"reference, same seed", reference, true, 0, nullptr},
+		{"reference, other seed", reference, false, 1, nullptr},
+		{"baseline update", baseline, false, 0, nullptr},
+		{"pull delivery, 1 worker", pullSingle, false, 0, nullptr},
+		{"pull delivery, 4 workers", pullParallel, false, 0, nullptr},
+		{"batched delivery", batched, false, 0, nullptr},
+		{"batched delivery / pull delivery, 1 worker", batched, true, 0, pullSingle},
+		{"replayed noise", replayed, true, 0, nullptr},
+	};
+
+	vector< vector<double> > ref = reference(seed, t_stop);
+
+	int failed(0);
+	for (size_t i(0); i<candidates.size(); ++i)
+	{
+		const Candidate& c = candidates[i];
+		vector< vector<double> > base = (c.base != nullptr) ? c.base(seed, t_stop) : ref;
+
+		if(!compare(c, base, c.run(seed+c.seedOffset, t_stop), t_stop))
+		{
+			++failed;
+		}
+	}
+
+	cout << failed << " candidate(s) rejected out of " << candidates.size() << endl;
+
+	return failed;
+}
@@ -0,0 +1,50 @@
+#ifndef wiring_HPP
+#define wiring_HPP
+
+#include <random>
+
+using namespace std;
+
+/*
+ * random wiring of the network of Brunel
+ *
+ * each neuron recieves its connections from ce excitatory and ci
+ * inhibitory neurons drawn at random (other than itself, a neuron can be
+ * drawn twice). NetworkT and FixedNetwork both draw their map here, so a
+ * seed gives them the same connections whatever their storage.
+ */
+
+/*!
+ * @brief draw the connections of a network whose ne first neurons are
+ * 		  excitatory
+ *
+ * @param mt19937 gen generator the connections are drawn from
+ * @param int ne, nn number of excitatory neurons and of neurons
+ * @param int ce, ci number of excitatory and inhibitory connections
+ * 		  recieved by each neuron
+ * @param Place place called as place(pre, post) for each connection, the
+ * 		  post-synaptic neurons in order
+ */
+template <class Place>
+void drawConnections(mt19937& gen, int ne, int nn, int ce, int ci, Place place)
+{
+	uniform_int_distribution<> disE(0, ne-1);
+	uniform_int_distribution<> disI(ne, nn-1);
+
+	for (int i(0); i<nn; ++i)
+	{
+		for (int k(0); k<ce+ci; ++k)
+		{
+			int r(0);
+
+			do
+			{
+				r = (k < ce) ? disE(gen) : disI(gen);
+			}while(r == i);
+
+			place(r, i);
+		}
+	}
+}
+
+#endif